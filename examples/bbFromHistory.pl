@@ -11,7 +11,7 @@ open (X, '<', "$ARGV[1]") or die("Impossible de lire $ARGV[1], $!\n");
 my $dimPb = scalar @vectX;
 my $nbOutputs = 1;
 my $nameCacheFile="history_log.txt";
-my $epsilon= 1.e-14;  # precision for matching points
+my $epsilon= 1.e-14;  # precision for matching points (histories written before the round-trip format were rounded)
 my $dimVectX= scalar @vectX;
 my $bbCommand = "./../src/blackbox/pytorch_bb.py Fashion-MNIST $ARGV[0]";
 
@@ -0,0 +1,48 @@
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------*/
+/*   Allocation counter of the benchmarks (see benchmarkUtils.hpp)   */
+/*-------------------------------------------------------------------*/
+#include "benchmarkUtils.hpp"
+
+std::atomic<size_t> allocationCount ( 0 );
+
+// Allocations are counted by replacing the global operator new (linked with each benchmark)
+void * operator new ( std::size_t size )
+{
+    allocationCount.fetch_add( 1 , std::memory_order_relaxed );
+    void * ptr = std::malloc( ( size > 0 ) ? size : 1 );
+    if ( ptr == nullptr )
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete ( void * ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete ( void * ptr , std::size_t ) noexcept
+{
+    std::free( ptr );
+}
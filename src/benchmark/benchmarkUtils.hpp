@@ -0,0 +1,150 @@
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------*/
+/*   Utilities shared by the benchmarks                              */
+/*-------------------------------------------------------------------*/
+#ifndef __BENCHMARKUTILS__
+#define __BENCHMARKUTILS__
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Number of allocations: the global operator new is replaced in benchmarkUtils.cpp, linked with each benchmark
+extern std::atomic<size_t> allocationCount;
+
+// Average time of a call in microseconds
+template<typename F>
+double timePerCall ( F f , size_t nbRepeats )
+{
+    auto start = std::chrono::steady_clock::now();
+    for ( size_t i = 0 ; i < nbRepeats ; i++ )
+        f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>( stop - start ).count() / nbRepeats;
+}
+
+struct Measure
+{
+    double timePerCall; // microseconds
+    double allocationsPerCall;
+};
+
+// Time and allocations per call. A first call is done to warm up.
+template<typename F>
+Measure measure ( F f , size_t nbRepeats )
+{
+    f();
+    size_t allocationsBefore = allocationCount.load();
+    double t = timePerCall( f , nbRepeats );
+    size_t allocations = allocationCount.load() - allocationsBefore;
+    return { t , static_cast<double>( allocations ) / nbRepeats };
+}
+
+// Machine-readable results (tab-separated, one line per measure) for regression tracking.
+// The lines are displayed and written in a file if a name is given.
+class BenchmarkReport
+{
+private:
+    std::string _benchmark;
+    std::vector<std::string> _lines;
+    
+public:
+    explicit BenchmarkReport ( const std::string & benchmark ) : _benchmark ( benchmark ) {}
+    
+    static std::string header ( ) { return "benchmark\tcase\tfunction\tmicrosecondsPerCall\tallocationsPerCall"; }
+    
+    void add ( const std::string & caseName , const std::string & function , const Measure & m )
+    {
+        std::ostringstream line;
+        line << _benchmark << "\t" << caseName << "\t" << function << "\t" << m.timePerCall << "\t" << m.allocationsPerCall;
+        _lines.push_back( line.str() );
+        std::cout << line.str() << std::endl;
+    }
+    
+    void write ( const std::string & fileName ) const
+    {
+        if ( fileName.empty() )
+            return;
+        std::ofstream fout ( fileName.c_str() );
+        fout << header() << std::endl;
+        for ( const auto & line : _lines )
+            fout << line << std::endl;
+    }
+};
+
+// Generate an hyperparameters file with X0, LOWER_BOUND and UPPER_BOUND given in vector form for numConvLayers convolution layers
+// and numFullLayers full layers. Each layer has a comment line as done by the sweep generators.
+// Other keywords can be added (one per line).
+inline void generateHyperParametersFile ( const std::string & fileName , size_t numConvLayers , size_t numFullLayers , const std::string & otherKeywords = "" )
+{
+    std::ofstream fout ( fileName.c_str() );
+    
+    fout << "# Generated file" << std::endl;
+    fout << "DATASET MNIST" << std::endl;
+    fout << "MAX_BB_EVAL 100" << std::endl;
+    fout << "HYPER_DISPLAY 0" << std::endl;
+    fout << otherKeywords;
+    
+    std::ostringstream x0, lb, ub;
+    x0 << "X0 ( " << numConvLayers << " ";
+    lb << "LOWER_BOUND ( 0 ";
+    ub << "UPPER_BOUND ( 100 ";
+    for ( size_t i = 0 ; i < numConvLayers ; i++ )
+    {
+        fout << "# conv layer " << i << ": out_channels kernel stride padding pooling" << std::endl;
+        x0 << "6 5 1 0 1 ";
+        lb << "1 1 1 0 1 ";
+        ub << "1000 20 3 2 5 ";
+    }
+    x0 << numFullLayers << " ";
+    lb << "0 ";
+    ub << "500 ";
+    for ( size_t i = 0 ; i < numFullLayers ; i++ )
+    {
+        fout << "# full layer " << i << std::endl;
+        x0 << "128 ";
+        lb << "1 ";
+        ub << "1000 ";
+    }
+    x0 << "128 3 0.1 0.9 0.0005 0 0.2 1 )";
+    lb << "1 1 0 0 0 0 0 1 )";
+    ub << "400 4 1 1 1 1 0.95 3 )";
+    
+    fout << x0.str() << std::endl;
+    fout << lb.str() << std::endl;
+    fout << ub.str() << std::endl;
+    
+    fout << "DROPOUT_RATE 0.5 - - FIXED" << std::endl;
+    fout << "KERNELS 10 - - FIXED" << std::endl;
+    fout << "REMAINING_HPS VAR" << std::endl;
+    
+    fout.close();
+}
+
+#endif
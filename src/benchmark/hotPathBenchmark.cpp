@@ -0,0 +1,87 @@
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------*/
+/*   Benchmark of the hot path of the extended poll: neighbors of a  */
+/*   point and their expansion in extended poll points               */
+/*-------------------------------------------------------------------*/
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+#include "hyperExtendedPoll.hpp"
+#include "benchmarkUtils.hpp"
+
+using namespace std;
+
+const std::string benchFileName = "hotPathBenchmark_hyperparameters.txt";
+
+// Functions of HyperParameters called at each poll of Nomad.
+// Usage: hotPathBenchmark.exe [nbRepeats] [resultFile]
+int main ( int argc , char ** argv )
+{
+    const size_t nbRepeats = ( argc > 1 ) ? std::atoi( argv[1] ) : 20;
+    const std::string resultFile = ( argc > 2 ) ? argv[2] : "";
+    
+    // The largest case has the heads of blocks on their upper bounds (100 conv layers and 500 full layers)
+    const std::pair<size_t,size_t> numLayers[] = { { 2 , 2 } , { 13 , 10 } , { 50 , 100 } , { 100 , 500 } };
+    
+    NOMAD::Display out ( std::cout );
+    
+    BenchmarkReport report ( "hotPath" );
+    std::cout << BenchmarkReport::header() << std::endl;
+    
+    for ( const auto & layers : numLayers )
+    {
+        generateHyperParametersFile( benchFileName , layers.first , layers.second );
+        
+        HyperParameters hp ( benchFileName , "pytorch_bb.py" , "pytorch_sgte.py" );
+        NOMAD::Point x0 = hp.getValues( ValueType::CURRENT_VALUE );
+        
+        std::ostringstream caseName;
+        caseName << "conv" << layers.first << "_full" << layers.second << "_dim" << hp.getDimension();
+        
+        report.add( caseName.str() , "updateFromBaseAndPerformExpansion" , measure( [&](){ hp.updateFromBaseAndPerformExpansion( x0 , true ); } , nbRepeats ) );
+        report.add( caseName.str() , "getValues" , measure( [&](){ hp.getValues( ValueType::CURRENT_VALUE ); } , nbRepeats ) );
+        report.add( caseName.str() , "getTypes" , measure( [&](){ hp.getTypes(); } , nbRepeats ) );
+        report.add( caseName.str() , "getVariableGroupsIndices" , measure( [&](){ hp.getVariableGroupsIndices(); } , nbRepeats ) );
+        report.add( caseName.str() , "getNeighboors" , measure( [&](){ hp.getNeighboors( x0 ); } , nbRepeats ) );
+        
+        // Same work as HyperExtendedPoll::construct_extended_points without a running Mads
+        NOMAD::Parameters p ( out );
+        p.set_BB_OUTPUT_TYPE( hp.getBbOutputType() );
+        p.set_BB_EXE( hp.getBB() );
+        report.add( caseName.str() , "constructExtendedPoints" , measure( [&](){
+            std::vector<HyperParameters> neighboors = hp.getNeighboors( x0 );
+            for ( auto & nHyperParameters : neighboors )
+            {
+                NOMAD::Parameters nP ( out );
+                HyperExtendedPoll::setNeighboorParameters( nHyperParameters , p , nP );
+                NOMAD::Point nX = nHyperParameters.getValues( ValueType::CURRENT_VALUE );
+                nP.get_signature();
+            }
+        } , nbRepeats ) );
+    }
+    
+    report.write( resultFile );
+    
+    std::remove( benchFileName.c_str() );
+    
+    return EXIT_SUCCESS;
+}
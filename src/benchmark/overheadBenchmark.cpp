@@ -0,0 +1,106 @@
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------*/
+/*   Benchmark of the overhead of the optimizer per evaluation with  */
+/*   the synthetic blackbox (neighborhood, signature, evaluator)     */
+/*-------------------------------------------------------------------*/
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+#include "hyperEvaluator.hpp"
+#include "hyperExtendedPoll.hpp"
+#include "syntheticBlackbox.hpp"
+#include "benchmarkUtils.hpp"
+
+using namespace std;
+
+const std::string benchFileName = "overheadBenchmark_hyperparameters.txt";
+
+// Overhead of HyperNomad with a synthetic blackbox (no training): the time spent by the optimizer
+// per neighborhood, per signature and per evaluation compared with the time of the objective itself.
+int main ( int argc , char ** argv )
+{
+    const size_t nbRepeats = ( argc > 1 ) ? std::atoi( argv[1] ) : 20;
+    
+    const size_t numConvLayers[] = { 2 , 13 , 50 , 100 };
+    const size_t numFullLayers[] = { 2 , 10 , 100 , 500 };
+    
+    NOMAD::Display out ( std::cout );
+    
+    std::shared_ptr<WorkerPool> workerPool = std::make_shared<WorkerPool>( 1 );
+    
+    std::cout << "Overhead with the synthetic:layers blackbox (microseconds), " << nbRepeats << " repetitions" << std::endl;
+    std::cout << "conv\tfull\tdim\tneighboors\tgetNeighboors\tsignature\tdriverPerEval\tobjectivePerEval" << std::endl;
+    
+    for ( size_t c : numConvLayers )
+    {
+        for ( size_t f : numFullLayers )
+        {
+            generateHyperParametersFile( benchFileName , c , f , "BB_EXE synthetic:layers\nINITIAL_DESIGN 100\n" );
+            
+            HyperParameters hp ( benchFileName , "pytorch_bb.py" , "pytorch_sgte.py" );
+            NOMAD::Point x0 = hp.getValues( ValueType::CURRENT_VALUE );
+            
+            // Neighborhood of the categorical variables (done at each extended poll)
+            size_t nbNeighboors = 0;
+            double tNeighboors = timePerCall( [&](){ nbNeighboors = hp.getNeighboors( x0 ).size(); } , nbRepeats );
+            
+            // Signature of each neighboor (new parameters checked by Nomad)
+            NOMAD::Parameters p ( out );
+            p.set_BB_OUTPUT_TYPE( hp.getBbOutputType() );
+            std::vector<HyperParameters> neighboors = hp.getNeighboors( x0 );
+            double tSignature = 0;
+            if ( ! neighboors.empty() )
+            {
+                tSignature = timePerCall( [&](){
+                    for ( const HyperParameters & n : neighboors )
+                    {
+                        NOMAD::Parameters nP ( out );
+                        HyperExtendedPoll::setNeighboorParameters( n , p , nP );
+                        nP.get_signature();
+                    }
+                } , nbRepeats ) / neighboors.size();
+            }
+            
+            // Evaluations of the initial design through the evaluator (a new cache each time to avoid hits)
+            std::vector<NOMAD::Point> design = hp.getInitialDesign();
+            double tDriver = timePerCall( [&](){
+                HyperEvaluator ev ( p , hp , workerPool , std::make_shared<EvaluationCache>() );
+                std::vector<NOMAD::Point> outputs;
+                ev.evaluate( design , outputs );
+            } , nbRepeats ) / design.size();
+            
+            // Same points with the objective function alone
+            SyntheticBlackbox bb ( HyperEvaluator::toShellCommand( hp.getBB() ) , hp );
+            double tObjective = timePerCall( [&](){
+                double obj;
+                for ( const NOMAD::Point & x : design )
+                    bb.computeObjective( x , obj );
+            } , nbRepeats ) / design.size();
+            
+            std::cout << c << "\t" << f << "\t" << hp.getDimension() << "\t" << nbNeighboors << "\t" << tNeighboors << "\t" << tSignature << "\t" << tDriver << "\t" << tObjective << std::endl;
+        }
+    }
+    
+    std::remove( benchFileName.c_str() );
+    
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------*/
+/*   Benchmark of the hyperparameters file parsing on large files    */
+/*-------------------------------------------------------------------*/
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+#include "hyperParametersFile.hpp"
+#include "benchmarkUtils.hpp"
+
+using namespace std;
+
+const std::string benchFileName = "parserBenchmark_hyperparameters.txt";
+
+// Reading done with the Nomad parameter entries (one allocation per line)
+size_t readWithParameterEntries ( const std::string & fileName )
+{
+    std::ifstream fin ( fileName.c_str() );
+    NOMAD::Parameter_Entries entries;
+    std::string s;
+    size_t nbEntries = 0;
+    while ( fin.good() && !fin.eof() )
+    {
+        s.clear();
+        getline ( fin , s );
+        NOMAD::string_vect_padding ( s );
+        if ( !fin.fail() && !s.empty() )
+        {
+            NOMAD::Parameter_Entry * pe = new NOMAD::Parameter_Entry ( s );
+            if ( pe->is_ok() )
+            {
+                entries.insert ( pe );
+                nbEntries++;
+            }
+            else
+                delete pe;
+        }
+    }
+    fin.close();
+    return nbEntries;
+}
+
+size_t readWithHyperParametersFile ( const std::string & fileName )
+{
+    HyperParametersFile file;
+    file.read( fileName );
+    return file.getEntries().size();
+}
+
+int main ( int argc , char ** argv )
+{
+    const size_t nbRepeats = ( argc > 1 ) ? std::atoi( argv[1] ) : 200;
+
+    const size_t numConvLayers[] = { 2 , 13 , 50 , 100 };
+    const size_t numFullLayers[] = { 2 , 10 , 100 , 500 };
+
+    std::cout << "Parsing time per file (microseconds), " << nbRepeats << " repetitions" << std::endl;
+    std::cout << "conv\tfull\tbytes\tnomadEntries\thyperParametersFile\thyperParameters" << std::endl;
+
+    for ( size_t c : numConvLayers )
+    {
+        for ( size_t f : numFullLayers )
+        {
+            generateHyperParametersFile( benchFileName , c , f );
+
+            std::ifstream in( benchFileName.c_str() , std::ios::binary | std::ios::ate );
+            std::streamoff bytes = in.tellg();
+            in.close();
+
+            double tEntries = timePerCall( [](){ readWithParameterEntries( benchFileName ); } , nbRepeats );
+            double tFile = timePerCall( [](){ readWithHyperParametersFile( benchFileName ); } , nbRepeats );
+
+            // Complete construction: reading + interpretation + expansion + checks
+            double tHyper = timePerCall( [](){ HyperParameters hp( benchFileName , "pytorch_bb.py" , "pytorch_sgte.py" ); } , nbRepeats );
+
+            std::cout << c << "\t" << f << "\t" << bytes << "\t" << tEntries << "\t" << tFile << "\t" << tHyper << std::endl;
+        }
+    }
+
+    std::remove( benchFileName.c_str() );
+
+    return EXIT_SUCCESS;
+}
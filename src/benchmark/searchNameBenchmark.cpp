@@ -0,0 +1,102 @@
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------*/
+/*   Benchmark of the setup time (schema + hyperparameters set by    */
+/*   name) when the number of hyperparameters in the schema grows    */
+/*-------------------------------------------------------------------*/
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+#include "benchmarkUtils.hpp"
+
+using namespace std;
+
+const std::string benchSchemaFileName = "searchNameBenchmark_schema.txt";
+const std::string benchFileName = "searchNameBenchmark_hyperparameters.txt";
+
+// Generate a schema with nbBlocks blocks. One block out of ten is a categorical block with a group of 3 associated hyperparameters.
+// The hyperparameters file sets every hyperparameter by name. Return the number of hyperparameters.
+size_t generateFiles ( size_t nbBlocks )
+{
+    std::ofstream schema ( benchSchemaFileName.c_str() );
+    std::ofstream fout ( benchFileName.c_str() );
+    
+    schema << "DATASETS MNIST" << std::endl;
+    
+    fout << "DATASET MNIST" << std::endl;
+    fout << "MAX_BB_EVAL 100" << std::endl;
+    fout << "HYPER_DISPLAY 0" << std::endl;
+    fout << "SEARCH_SPACE_SCHEMA " << benchSchemaFileName << std::endl;
+    
+    size_t nbHyperParameters = 0;
+    for ( size_t i = 0 ; i < nbBlocks ; i++ )
+    {
+        if ( i % 10 == 0 )
+        {
+            schema << "BLOCK \"Layers " << i << "\" PLUS_ONE_MINUS_ONE_RIGHT MULTIPLE_TIMES" << std::endl;
+            schema << "HEAD NUM_LAYERS_" << i << " \"Number of layers\" CATEGORICAL 2 0 5" << std::endl;
+            fout << "NUM_LAYERS_" << i << " 3" << std::endl;
+            for ( size_t j = 0 ; j < 3 ; j++ )
+            {
+                schema << "ASSOCIATED SIZE_" << i << "_" << j << " \"Size\" INTEGER 10 1 100 COPY_VALUE" << std::endl;
+                fout << "SIZE_" << i << "_" << j << " 20 - - VAR" << std::endl;
+            }
+            nbHyperParameters += 4;
+        }
+        else
+        {
+            schema << "BLOCK \"Parameter " << i << "\" NONE ZERO_TIME" << std::endl;
+            schema << "HEAD PARAM_" << i << " \"Parameter\" CONTINUOUS 0.5 0 1" << std::endl;
+            fout << "PARAM_" << i << " 0.25 0 1" << std::endl;
+            nbHyperParameters++;
+        }
+    }
+    
+    schema.close();
+    fout.close();
+    
+    return nbHyperParameters;
+}
+
+int main ( int argc , char ** argv )
+{
+    const size_t nbRepeats = ( argc > 1 ) ? std::atoi( argv[1] ) : 20;
+    
+    const size_t nbBlocks[] = { 10 , 100 , 1000 , 10000 };
+    
+    std::cout << "Setup time (microseconds), " << nbRepeats << " repetitions" << std::endl;
+    std::cout << "blocks\thyperParameters\tsetup\tsetupPerHyperParameter" << std::endl;
+    
+    for ( size_t n : nbBlocks )
+    {
+        size_t nbHyperParameters = generateFiles( n );
+        
+        // Complete construction: schema compilation + reading + interpretation + expansion + checks
+        double t = timePerCall( [](){ HyperParameters hp( benchFileName , "pytorch_bb.py" , "pytorch_sgte.py" ); } , nbRepeats );
+        
+        std::cout << n << "\t" << nbHyperParameters << "\t" << t << "\t" << t / nbHyperParameters << std::endl;
+    }
+    
+    std::remove( benchFileName.c_str() );
+    std::remove( benchSchemaFileName.c_str() );
+    
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+
+/*-------------------------------------------------------------------*/
+/*   Benchmark of the startup of the hypernomad executable           */
+/*-------------------------------------------------------------------*/
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+#include "fileutils.hpp"
+#include "benchmarkUtils.hpp"
+
+#ifdef _MSC_VER
+#include <cstdlib>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#endif
+
+using namespace std;
+
+const std::string benchFileName = "startupBenchmark_hyperparameters.txt";
+
+// The campaign is run in a directory of its own (history.txt and stats.txt are written in the current directory)
+const std::string runDir = "startupBenchmark_run";
+
+// Run the executable with the given arguments in runDir, outputs discarded. Return false if the run failed.
+bool runExecutable ( const std::string & exe , const std::vector<std::string> & args )
+{
+#ifdef _MSC_VER
+    std::string command = "cd /d " + runDir + " && \"" + exe + "\"";
+    for ( const auto & arg : args )
+        command += " \"" + arg + "\"";
+    command += " > NUL 2>&1";
+    return ( std::system( command.c_str() ) == 0 );
+#else
+    std::vector<char *> argv;
+    argv.push_back( const_cast<char *>( exe.c_str() ) );
+    for ( const auto & arg : args )
+        argv.push_back( const_cast<char *>( arg.c_str() ) );
+    argv.push_back( nullptr );
+    
+    pid_t pid = fork();
+    if ( pid < 0 )
+        return false;
+    if ( pid == 0 )
+    {
+        int devNull = open( "/dev/null" , O_WRONLY );
+        dup2( devNull , STDOUT_FILENO );
+        dup2( devNull , STDERR_FILENO );
+        if ( chdir( runDir.c_str() ) != 0 )
+            _exit( 127 );
+        execv( exe.c_str() , argv.data() );
+        _exit( 127 );
+    }
+    int status;
+    if ( waitpid( pid , &status , 0 ) != pid )
+        return false;
+    return ( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 );
+#endif
+}
+
+// Startup of the hypernomad executable (static or dynamic build) and of a campaign on the synthetic blackbox.
+// The executable is given by the HYPERNOMAD_EXE environment variable (set by make bench), bin/hypernomad.exe by default.
+// Usage: startupBenchmark.exe [nbRepeats] [resultFile]
+int main ( int argc , char ** argv )
+{
+    const size_t nbRepeats = ( argc > 1 ) ? std::atoi( argv[1] ) : 20;
+    const std::string resultFile = ( argc > 2 ) ? argv[2] : "";
+    
+    const char * exeEnv = getenv( "HYPERNOMAD_EXE" );
+    std::string exe = ( exeEnv == nullptr ) ? "bin" + std::string( dirSep ) + "hypernomad.exe" : exeEnv;
+    if ( exe.substr( 0 , 1 ).compare( dirSep ) != 0 )
+        exe = curDir() + dirSep + exe;
+    
+    if ( ! checkAccess( exe ) )
+    {
+        std::cerr << "Cannot access " << exe << ": set the HYPERNOMAD_EXE environment variable." << std::endl;
+        return EXIT_FAILURE;
+    }
+    
+    // A campaign of one evaluation on the synthetic blackbox (no Python, no HYPERNOMAD_HOME) with the default schema
+    std::ofstream fout ( benchFileName.c_str() );
+    fout << "DATASET MNIST" << std::endl;
+    fout << "BB_EXE synthetic:layers" << std::endl;
+    fout << "MAX_BB_EVAL 1" << std::endl;
+    fout << "HYPER_DISPLAY 0" << std::endl;
+    fout.close();
+    const std::string hyperParamFile = curDir() + dirSep + benchFileName;
+    
+#ifdef _MSC_VER
+    _mkdir( runDir.c_str() );
+#else
+    mkdir( runDir.c_str() , 0755 );
+#endif
+    
+    BenchmarkReport report ( "startup" );
+    std::cout << BenchmarkReport::header() << std::endl;
+    
+    const std::string caseName = trimDir( exe );
+    bool success = true;
+    
+    report.add( caseName , "version" , measure( [&](){ success = runExecutable( exe , { "-v" } ) && success; } , nbRepeats ) );
+    report.add( caseName , "defaultSchema" , measure( [&](){ success = runExecutable( exe , { "-s" } ) && success; } , nbRepeats ) );
+    report.add( caseName , "syntheticCampaign" , measure( [&](){ success = runExecutable( exe , { hyperParamFile } ) && success; } , nbRepeats ) );
+    
+    // Part of the campaign startup done in process
+    report.add( caseName , "readHyperParameters" , measure( [&](){ HyperParameters hp ( hyperParamFile , "pytorch_bb.py" , "pytorch_sgte.py" ); } , nbRepeats ) );
+    
+    report.write( resultFile );
+    
+    std::remove( benchFileName.c_str() );
+    std::remove( ( runDir + dirSep + "history.txt" ).c_str() );
+    std::remove( ( runDir + dirSep + "stats.txt" ).c_str() );
+#ifdef _MSC_VER
+    _rmdir( runDir.c_str() );
+#else
+    rmdir( runDir.c_str() );
+#endif
+    
+    if ( ! success )
+    {
+        std::cerr << "A run of " << exe << " failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+    
+    return EXIT_SUCCESS;
+}
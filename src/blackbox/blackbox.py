@@ -19,109 +19,226 @@
 #
 #  You can find information on the NOMAD software at www.gerad.ca/nomad
 # ------------------------------------------------------------------------------
-
 import torch
 import torch.optim as optim
 import torch.utils.data
 import torch.backends.cudnn as cudnn
 import os
 import sys
+import random
+import time
 from datahandler import DataHandler
 from evaluator import *
+from metrics import TraceWriter
 from neural_net import NeuralNet
 
 
-# Read the inputs sent from HyperNOMAD
-device = torch.device("cuda:0" if torch.cuda.is_available() else "cpu")
-
-print('> Reading the inputs..')
-# get the dataset
-dataset = str(sys.argv[1])
-
-# Architecture
-num_conv_layers = int(sys.argv[2])
-
-shift = 0
-list_param_conv_layers = []
-for i in range(num_conv_layers):
-    conv_layer_param = (int(sys.argv[3 + shift]), int(sys.argv[4 + shift]), int(sys.argv[5 + shift]),
-                        int(sys.argv[6 + shift]), int(sys.argv[7 + shift]))
-    list_param_conv_layers += [conv_layer_param]
-    shift += 5
-
-last_index = shift + 2
-num_full_layers = int(sys.argv[last_index + 1])
-list_param_full_layers = []
-for i in range(num_full_layers):
-    list_param_full_layers += [int(sys.argv[last_index + 2 + i])]
-
-# First 2 : blackbox.py, dataset
-batch_size_index = 2 + (2 + num_conv_layers*5 + num_full_layers)
-batch_size = int(sys.argv[batch_size_index])
-
-# HPs
-optimizer_choice = int(sys.argv[batch_size_index + 1])
-arg1 = float(sys.argv[batch_size_index + 2])               # lr
-arg2 = float(sys.argv[batch_size_index + 3])               # momentum
-arg3 = float(sys.argv[batch_size_index + 4])               # weight decay
-arg4 = float(sys.argv[batch_size_index + 5])               # dampening
-dropout_rate = float(sys.argv[batch_size_index + 6])
-activation = int(sys.argv[batch_size_index + 7])
-
-# Load the data
-print('> Preparing the data..')
-
-if dataset is not 'CUSTOM':
-    dataloader = DataHandler(dataset, batch_size)
-    image_size, number_classes = dataloader.get_info_data
-    trainloader, validloader, testloader = dataloader.get_loaders()
-else:
-    # Add here the adequate information
-    image_size = None
-    number_classes = None
-    trainloader = None
-    validloader = None
-    testloader = None
-
-# Test if the correct information is passed - especially in the case of CUSTOM dataset
-assert isinstance(trainloader, torch.utils.data.dataloader.DataLoader), 'Trainloader given is not of class DataLoader'
-assert isinstance(validloader, torch.utils.data.dataloader.DataLoader), 'Validloader given is not of class DataLoader'
-assert isinstance(testloader, torch.utils.data.dataloader.DataLoader), 'Testloader given is not of class DataLoader'
-assert image_size is not None, 'Image size can not be None'
-assert number_classes is not None, 'Total number of classes can not be None'
-
-num_input_channels = image_size[0]
-
-print('> Constructing the network')
-# construct the network
-cnn = NeuralNet(num_conv_layers, num_full_layers, list_param_conv_layers, list_param_full_layers,
-                dropout_rate, activation, image_size[1], number_classes, num_input_channels)
-
-cnn.to(device)
-
-try:
-    if optimizer_choice == 1:
-        optimizer = optim.SGD(cnn.parameters(), lr=arg1, momentum=arg2, weight_decay=arg3,
-                              dampening=arg4)
-    if optimizer_choice == 2:
-        optimizer = optim.Adam(cnn.parameters(), lr=arg1, betas=(arg2, arg3), weight_decay=arg4)
-    if optimizer_choice == 3:
-        optimizer = optim.Adagrad(cnn.parameters(), lr=arg1, lr_decay=arg2, weight_decay=arg4,
-                                  initial_accumulator_value=arg3)
-    if optimizer_choice == 4:
-        optimizer = optim.RMSprop(cnn.parameters(), lr=arg1, momentum=arg2, alpha=arg3, weight_decay=arg4)
-except ValueError:
-    print('optimizer got an empty list')
-    exit(0)
-
-print(cnn)
-
-# The evaluator trains and tests the network
-evaluator = Evaluator(device, cnn, trainloader, validloader, testloader, optimizer, batch_size, dataset)
-print('> Training')
-best_val_acc, best_epoch = evaluator.train()
-print('> Testing')
-test_acc = evaluator.test()
-
-# Output of the blackbox
-print('> Final accuracy %.3f' % test_acc)
+def set_seed(seed):
+    """Replicated evaluations (REPLICATIONS) are launched with a controlled seed"""
+    random.seed(seed)
+    torch.manual_seed(seed)
+    if torch.cuda.is_available():
+        torch.cuda.manual_seed_all(seed)
+
+
+# Integer values are rounded: the values can be given as strings (command line) or as doubles (shared memory)
+def to_int(value):
+    return int(round(float(value)))
+
+
+def read_point(x):
+    """Architecture and hyperparameters given by the point x (values in the order of HyperNOMAD)"""
+    # Architecture
+    num_conv_layers = to_int(x[0])
+
+    shift = 0
+    list_param_conv_layers = []
+    for i in range(num_conv_layers):
+        conv_layer_param = (to_int(x[1 + shift]), to_int(x[2 + shift]), to_int(x[3 + shift]),
+                            to_int(x[4 + shift]), to_int(x[5 + shift]))
+        list_param_conv_layers += [conv_layer_param]
+        shift += 5
+
+    last_index = shift
+    num_full_layers = to_int(x[last_index + 1])
+    list_param_full_layers = []
+    for i in range(num_full_layers):
+        list_param_full_layers += [to_int(x[last_index + 2 + i])]
+
+    batch_size_index = 2 + num_conv_layers*5 + num_full_layers
+
+    return {'num_conv_layers': num_conv_layers,
+            'list_param_conv_layers': list_param_conv_layers,
+            'num_full_layers': num_full_layers,
+            'list_param_full_layers': list_param_full_layers,
+            'batch_size': to_int(x[batch_size_index]),
+            # HPs
+            'optimizer_choice': to_int(x[batch_size_index + 1]),
+            'arg1': float(x[batch_size_index + 2]),             # lr
+            'arg2': float(x[batch_size_index + 3]),             # momentum
+            'arg3': float(x[batch_size_index + 4]),             # weight decay
+            'arg4': float(x[batch_size_index + 5]),             # dampening
+            'dropout_rate': float(x[batch_size_index + 6]),
+            'activation': to_int(x[batch_size_index + 7])}
+
+
+def build_network(p, image_size, number_classes, device):
+    """Network and optimizer of the point read by read_point (None, None if the optimizer cannot be built)"""
+    num_input_channels = image_size[0]
+
+    print('> Constructing the network')
+    # construct the network
+    cnn = NeuralNet(p['num_conv_layers'], p['num_full_layers'], p['list_param_conv_layers'], p['list_param_full_layers'],
+                    p['dropout_rate'], p['activation'], image_size[1], number_classes, num_input_channels)
+
+    cnn.to(device)
+
+    optimizer_choice = p['optimizer_choice']
+    arg1, arg2, arg3, arg4 = p['arg1'], p['arg2'], p['arg3'], p['arg4']
+    try:
+        if optimizer_choice == 1:
+            optimizer = optim.SGD(cnn.parameters(), lr=arg1, momentum=arg2, weight_decay=arg3,
+                                  dampening=arg4)
+        if optimizer_choice == 2:
+            optimizer = optim.Adam(cnn.parameters(), lr=arg1, betas=(arg2, arg3), weight_decay=arg4)
+        if optimizer_choice == 3:
+            optimizer = optim.Adagrad(cnn.parameters(), lr=arg1, lr_decay=arg2, weight_decay=arg4,
+                                      initial_accumulator_value=arg3)
+        if optimizer_choice == 4:
+            optimizer = optim.RMSprop(cnn.parameters(), lr=arg1, momentum=arg2, alpha=arg3, weight_decay=arg4)
+    except ValueError:
+        print('optimizer got an empty list')
+        return None, None
+
+    print(cnn)
+    return cnn, optimizer
+
+
+def evaluate(dataset, x, outputs=(), model_prefix=None):
+    """Train and test the network given by the point x (values in the order of HyperNOMAD).
+    Return a dictionary with the test accuracy and the requested outputs (TRAINING_TIME, LATENCY),
+    or None if the network cannot be trained. The best model is saved in model_prefix.0.pth (by default the prefix
+    is best_model.PID) and removed after the test."""
+    return evaluate_pack(dataset, [x], outputs, model_prefix)[0]
+
+
+def evaluate_pack(dataset, points, outputs=(), model_prefix=None):
+    """Train several networks with the same batch size together (CO_SCHEDULING): the data is loaded once and each
+    batch is given to all the networks. Return the results of evaluate for each point (None for a failed network).
+    The training time of a network of a pack is the time of its own steps and its share of the data loading."""
+    device = torch.device("cuda:0" if torch.cuda.is_available() else "cpu")
+
+    print('> Reading the inputs..')
+    params = [read_point(x) for x in points]
+    batch_size = params[0]['batch_size']
+    assert all(p['batch_size'] == batch_size for p in params), 'The networks trained together must have the same batch size'
+
+    # Load the data
+    print('> Preparing the data..')
+
+    if dataset is not 'CUSTOM':
+        dataloader = DataHandler(dataset, batch_size)
+        image_size, number_classes = dataloader.get_info_data
+        trainloader, validloader, testloader = dataloader.get_loaders()
+    else:
+        # Add here the adequate information
+        image_size = None
+        number_classes = None
+        trainloader = None
+        validloader = None
+        testloader = None
+
+    # Test if the correct information is passed - especially in the case of CUSTOM dataset
+    assert isinstance(trainloader, torch.utils.data.dataloader.DataLoader), 'Trainloader given is not of class DataLoader'
+    assert isinstance(validloader, torch.utils.data.dataloader.DataLoader), 'Validloader given is not of class DataLoader'
+    assert isinstance(testloader, torch.utils.data.dataloader.DataLoader), 'Testloader given is not of class DataLoader'
+    assert image_size is not None, 'Image size can not be None'
+    assert number_classes is not None, 'Total number of classes can not be None'
+
+    # Epoch budget given by HyperNOMAD (MAX_EPOCHS)
+    max_epochs = None
+    if 'HYPERNOMAD_MAX_EPOCHS' in os.environ:
+        max_epochs = int(os.environ.get('HYPERNOMAD_MAX_EPOCHS'))
+
+    # The evaluators train and test the networks (one best model file per network and per process, or per worker of
+    # shared memory: HyperNOMAD runs several blackboxes at once in the same directory)
+    if model_prefix is None:
+        model_prefix = 'best_model.%d' % os.getpid()
+    model_files = ['%s.%d.pth' % (model_prefix, k) for k in range(len(points))]
+    try:
+        evaluators = []
+        for k, p in enumerate(params):
+            cnn, optimizer = build_network(p, image_size, number_classes, device)
+            if cnn is None:
+                evaluators.append(None)
+                continue
+            evaluator = Evaluator(device, cnn, trainloader, validloader, testloader, optimizer, batch_size, dataset)
+            evaluator.start_training(model_files[k], max_epochs)
+            evaluators.append(evaluator)
+
+        print('> Training')
+        # Metrics of each epoch collected by HyperNOMAD (plotted offline with plot_traces.py)
+        trace = TraceWriter(os.environ.get('HYPERNOMAD_TRACE'))
+        trained = [evaluator for evaluator in evaluators if evaluator is not None]
+        if trained:
+            train_together(trained, trace)
+        trace.close()
+
+        results = []
+        for k, evaluator in enumerate(evaluators):
+            if evaluator is None or evaluator.finish_training()[0] is None:
+                results.append(None)
+                continue
+
+            result = {'TRAINING_TIME': evaluator.training_time}
+            print('> Testing')
+            result['accuracy'] = evaluator.test()
+
+            # Inference latency of the best model on CPU (only when requested by HyperNOMAD: SECOND_OBJECTIVE LATENCY, MAX_LATENCY)
+            if 'LATENCY' in outputs:
+                print('> Measuring the latency')
+                latencies = evaluator.latency(image_size)
+                for batch_size in sorted(latencies):
+                    print('> Latency batch %d %.3f ms' % (batch_size, latencies[batch_size]))
+                result['LATENCY'] = latencies[1]
+            results.append(result)
+    finally:
+        # The best models are temporary (also when the evaluation raises: a worker goes on with the next point)
+        for model_file in model_files:
+            if os.path.exists(model_file):
+                os.remove(model_file)
+
+    return results
+
+
+if __name__ == '__main__':
+
+    if 'HYPERNOMAD_SEED' in os.environ:
+        set_seed(int(os.environ.get('HYPERNOMAD_SEED')))
+
+    outputs = os.environ.get('HYPERNOMAD_OUTPUTS', '').split(',')
+
+    # Networks trained together (CO_SCHEDULING): dataset followed by --pack and a file with one point per line.
+    # The outputs of each network are prefixed by its position.
+    if len(sys.argv) == 4 and sys.argv[2] == '--pack':
+        with open(sys.argv[3]) as f:
+            points = [line.split() for line in f if line.strip()]
+        for k, results in enumerate(evaluate_pack(str(sys.argv[1]), points, outputs)):
+            if results is None:
+                continue
+            print('> Network %d: Final accuracy %.3f' % (k, results['accuracy']))
+            print('> Network %d: Training time %.3f' % (k, results['TRAINING_TIME']))
+            if 'LATENCY' in results:
+                print('> Network %d: Inference latency %.3f' % (k, results['LATENCY']))
+        exit(0)
+
+    # Read the inputs sent from HyperNOMAD: dataset followed by the point
+    results = evaluate(str(sys.argv[1]), sys.argv[2:], outputs)
+    if results is None:
+        exit(0)
+
+    # Output of the blackbox
+    print('> Final accuracy %.3f' % results['accuracy'])
+    print('> Training time %.3f' % results['TRAINING_TIME'])
+    if 'LATENCY' in results:
+        print('> Inference latency %.3f' % results['LATENCY'])
@@ -25,14 +25,13 @@ import torch.optim as optim
 import torch.utils.data
 import torch.backends.cudnn as cudnn
 import statistics
-import matplotlib.pyplot as plt
-import matplotlib.animation as animation
-from matplotlib import style
+import copy
 import time
 import os
 import sys
 from neural_net import *
 from datahandler import *
+from metrics import EpochMetrics, TraceWriter
 
 sys.path.append(os.environ.get('HYPERNOMAD_HOME')+"/src/blackbox/blackbox")
 
@@ -51,6 +50,7 @@ class Evaluator(object):
         self.__val_acc = None
         self.__test_acc = None
         self.__best_epoch = None
+        self.__model_file = None
 
     @property
     def device(self):
@@ -88,121 +88,134 @@ class Evaluator(object):
     def dataset(self):
         return self.__dataset
 
-    def train(self):
-        criterion = nn.CrossEntropyLoss()
+    def train(self, trace_file=None):
+        """Headless training: the metrics of each epoch are written in trace_file (CSV, see metrics.py)"""
+        trace = TraceWriter(trace_file)
+        self.start_training()
+        train_together([self], trace)
+        trace.close()
+        return self.finish_training()
+
+    # The training loop is split in steps so that train_together can train several networks on the same batches
+
+    def start_training(self, model_file=None, max_epochs=None):
+        """model_file: best model saved during the training (by default one per process: several blackboxes can run
+        in the same directory)"""
+        self.__criterion = nn.CrossEntropyLoss()
 
         if torch.cuda.is_available():
             self.cnn = torch.nn.DataParallel(self.cnn)
             cudnn.benchmark = True
 
-        epoch = 0
-        stop = False
-        l_val_acc = []
-        l_train_acc = []
-        best_val_acc = 0
-        epochs = []
-        max_epochs = 100
-        if self.dataset =='MINIMNIST':
-            max_epochs = 50
-
-        # plots
-        fig = plt.figure()
-        ax1 = fig.add_subplot(111)
-        ax1.set_title('Training and validation accuracies')
-        ax1.set_xlabel('Number of epochs')
-        ax1.set_ylabel('Accuracies')
-        plt.ion()
-        
+        self.__model_file = model_file if model_file is not None else 'best_model.%d.pth' % os.getpid()
+        self.__training_time = 0
+        self.__epoch = 0
+        self.__stop = False
+        self.__failed = False
+        self.__l_val_acc = []
+        self.__l_train_acc = []
+        self.__best_val_acc = 0
+        self.__max_epochs = 100
+        if self.dataset == 'MINIMNIST':
+            self.__max_epochs = 50
+        if max_epochs is not None:
+            self.__max_epochs = min(self.__max_epochs, max_epochs)
+
         # LR scheduler - SGD only
         T_max = 10
-        scheduler = optim.lr_scheduler.CosineAnnealingLR(self.optimizer, T_max, eta_min=0.001, last_epoch=-1)
-
-        while (not stop) and (epoch < max_epochs):
-            self.cnn.train()
-            train_loss = 0
-            correct = 0
-            total = 0
-            for batch_idx, (inputs, targets) in enumerate(self.trainloader):
-                inputs, targets = inputs.to(self.device), targets.to(self.device)
-                self.optimizer.zero_grad()
-                outputs = self.cnn(inputs)
-                loss = criterion(outputs, targets)
-                loss.backward()
-                self.optimizer.step()
+        self.__scheduler = optim.lr_scheduler.CosineAnnealingLR(self.optimizer, T_max, eta_min=0.001, last_epoch=-1)
 
-                train_loss += loss.item()
-                _, predicted = outputs.max(1)
-                total += targets.size(0)
-                correct += predicted.eq(targets).sum().item()
-                self.__train_acc = 100. * correct / total
-
-            l_train_acc.append(self.__train_acc)
-
-            self.cnn.eval()
-            val_loss = 0
-            val_correct = 0
-            val_total = 0
-            with torch.no_grad():
-                for batch_idx, (inputs, targets) in enumerate(self.validloader):
-                    inputs, targets = inputs.to(self.device), targets.to(self.device)
-                    outputs = self.cnn(inputs)
-                    loss = criterion(outputs, targets)
-                    val_loss += loss.item()
-                    _, predicted = outputs.max(1)
-                    val_total += targets.size(0)
-                    val_correct += predicted.eq(targets).sum().item()
-                    self.__val_acc = 100. * val_correct / val_total
-            if self.__val_acc > best_val_acc:
-                best_val_acc = self.__val_acc
-                torch.save(self.cnn.state_dict(), 'best_model.pth')
-            l_val_acc.append(self.__val_acc)
-
-            epochs.append(epoch)
-
-            ax1.plot(epochs, l_train_acc, color='r', label='Training accuracy')
-            ax1.plot(epochs, l_val_acc, color='b', label='Validation accuracy')
-            handles, labels = ax1.get_legend_handles_labels()
-            handle_list, label_list = [], []
-            for handle, label in zip(handles, labels):
-                if label not in label_list:
-                    handle_list.append(handle)
-                    label_list.append(label)
-            ax1.legend(handle_list, label_list, loc='best')
-            # ax1.legend(loc='best')
-
-            plt.pause(1e-6)
-
-            # Stop early
-            if (epoch == 25) and (best_val_acc < 20):
-                stop = True
-
-            # Early stopping criteria
-            if (epoch > 49) and (epoch % 50 == 0):
-                l_train = l_train_acc[epoch - 50:epoch]
-                l_val = l_val_acc[epoch - 50:epoch]
-                std_train = statistics.stdev(l_train)
-                std_val = statistics.stdev(l_val)
-                if std_train < 0.001:
-                    stop = True
-                if (std_train > 0.001) and (std_val < 0.001):
-                    stop = True
-
-            if self.optimizer.__class__.__name__ == 'SGD':                                                                      
-                # if epoch % 100 == 0:                                                                                          
-                #     for param_group in self.optimizer.param_groups:                                                           
-                #         if param_group['lr'] > 1e-6:                                                                          
-                #             param_group['lr'] /= 10                                                                           
-                scheduler.step() 
-
-            print("Epoch {},  Train accuracy: {:.3f}, Val accuracy: {:.3f}".format(epoch + 1, self.__train_acc,
-                                                                                   self.__val_acc))
-            epoch += 1
+    @property
+    def training_done(self):
+        return self.__stop or self.__failed or (self.__epoch >= self.__max_epochs)
+
+    @property
+    def failed(self):
+        return self.__failed
 
+    @property
+    def training_time(self):
+        """Training time in seconds of this network (see train_together)"""
+        return self.__training_time
+
+    def add_training_time(self, seconds):
+        self.__training_time += seconds
+
+    def fail(self, error):
+        print('> Training failed: ' + str(error))
+        self.__failed = True
+
+    def start_epoch(self):
+        self.cnn.train()
+        self.__train_metrics = EpochMetrics(self.device)
+        self.__val_metrics = EpochMetrics(self.device)
+
+    def train_step(self, inputs, targets):
+        self.optimizer.zero_grad()
+        outputs = self.cnn(inputs)
+        loss = self.__criterion(outputs, targets)
+        loss.backward()
+        self.optimizer.step()
+        self.__train_metrics.add(loss, outputs, targets)
+
+    def start_validation(self):
+        self.cnn.eval()
+
+    def validation_step(self, inputs, targets):
+        outputs = self.cnn(inputs)
+        loss = self.__criterion(outputs, targets)
+        self.__val_metrics.add(loss, outputs, targets)
+
+    def end_epoch(self, trace, network=None):
+        """Read the metrics of the epoch (one synchronization), keep the best model and check the stopping criteria"""
+        epoch = self.__epoch
+        l_train_acc = self.__l_train_acc
+        l_val_acc = self.__l_val_acc
+
+        train_loss, self.__train_acc = self.__train_metrics.flush()
+        l_train_acc.append(self.__train_acc)
+
+        val_loss, self.__val_acc = self.__val_metrics.flush()
+        if self.__val_acc > self.__best_val_acc:
+            self.__best_val_acc = self.__val_acc
+            torch.save(self.cnn.state_dict(), self.__model_file)
+        l_val_acc.append(self.__val_acc)
+
+        trace.write(epoch + 1, train_loss, self.__train_acc, val_loss, self.__val_acc,
+                    self.optimizer.param_groups[0]['lr'], network)
+
+        # Stop early
+        if (epoch == 25) and (self.__best_val_acc < 20):
+            self.__stop = True
+
+        # Early stopping criteria
+        if (epoch > 49) and (epoch % 50 == 0):
+            l_train = l_train_acc[epoch - 50:epoch]
+            l_val = l_val_acc[epoch - 50:epoch]
+            std_train = statistics.stdev(l_train)
+            std_val = statistics.stdev(l_val)
+            if std_train < 0.001:
+                self.__stop = True
+            if (std_train > 0.001) and (std_val < 0.001):
+                self.__stop = True
+
+        if self.optimizer.__class__.__name__ == 'SGD':
+            self.__scheduler.step()
+
+        prefix = '' if network is None else 'Network {}: '.format(network)
+        print(prefix + "Epoch {},  Train accuracy: {:.3f}, Val accuracy: {:.3f}".format(epoch + 1, self.__train_acc,
+                                                                                    self.__val_acc))
+        self.__epoch += 1
+
+    def finish_training(self):
+        """Best validation accuracy and its epoch (None, None if the training failed)"""
+        if self.__failed or not self.__l_val_acc:
+            return None, None
         print('> Finished Training')
 
         # get the best validation accuracy and the corresponding epoch
-        best_epoch = np.argmax(l_val_acc)
-        best_val_acc = l_val_acc[best_epoch]
+        best_epoch = np.argmax(self.__l_val_acc)
+        best_val_acc = self.__l_val_acc[best_epoch]
 
         # use the saved net to assess the test accuracy
         print('Best validation accuracy and corresponding epoch number : {:.3f}/{}'.format(best_val_acc, best_epoch + 1))
@@ -210,7 +223,7 @@ class Evaluator(object):
 
     def test(self):
         criterion = nn.CrossEntropyLoss()
-        self.cnn.load_state_dict(torch.load('best_model.pth'))
+        self.cnn.load_state_dict(torch.load(self.__model_file))
 
         total_test = 0
         correct_test = 0
@@ -231,6 +244,95 @@ class Evaluator(object):
         # exit(0)
         return test_acc
 
+    def latency(self, image_size, batch_sizes=(1, 32), warmup=10, repetitions=30):
+        """Median time (ms) of a forward pass of the best model (model file of the training, loaded by test) on CPU for each batch size"""
+        model = self.cnn.module if isinstance(self.cnn, torch.nn.DataParallel) else self.cnn
+        model = copy.deepcopy(model).cpu()
+        model.eval()
+
+        latencies = {}
+        with torch.no_grad():
+            for batch_size in batch_sizes:
+                inputs = torch.randn(batch_size, *image_size)
+                for i in range(warmup):
+                    model(inputs)
+                times = []
+                for i in range(repetitions):
+                    start = time.perf_counter()
+                    model(inputs)
+                    times.append(1000. * (time.perf_counter() - start))
+                latencies[batch_size] = statistics.median(times)
+        return latencies
+
+
+def train_together(evaluators, trace):
+    """Train the networks of the evaluators (started with start_training) on the same batches: the batches are loaded
+    and copied to the device once for all the networks. The loaders of the first evaluator are used (same batch size).
+    With several networks, the lines of the trace start with the position of the network. A network that fails is dropped.
+    The training time of a network alone is the wall time. With several networks, it is the time of its own steps
+    (synchronized on GPU) and its share of the loading of the batches."""
+    device = evaluators[0].device
+    trainloader = evaluators[0].trainloader
+    validloader = evaluators[0].validloader
+    packed = len(evaluators) > 1
+    network = (lambda k: k) if packed else (lambda k: None)
+    synchronize = torch.cuda.synchronize if packed and torch.cuda.is_available() else (lambda: None)
+    start_time = time.time()
+
+    def timed(evaluator, method, *args):
+        start = time.time()
+        method(evaluator, *args)
+        synchronize()
+        if packed:
+            evaluator.add_training_time(time.time() - start)
+
+    def step(active, method, inputs, targets):
+        for evaluator in active:
+            if evaluator.failed:
+                continue
+            try:
+                timed(evaluator, method, inputs, targets)
+            except RuntimeError as e:
+                evaluator.fail(e)
+
+    def batches(loader, active):
+        """Batches copied to the device, the loading time is shared by the networks"""
+        iterator = iter(loader)
+        while True:
+            start = time.time()
+            try:
+                inputs, targets = next(iterator)
+            except StopIteration:
+                return
+            inputs, targets = inputs.to(device), targets.to(device)
+            synchronize()
+            running = [evaluator for evaluator in active if not evaluator.failed]
+            if packed and running:
+                for evaluator in running:
+                    evaluator.add_training_time((time.time() - start) / len(running))
+            yield inputs, targets
+
+    active = [evaluator for evaluator in evaluators if not evaluator.training_done]
+    while active:
+        for evaluator in active:
+            evaluator.start_epoch()
+        for inputs, targets in batches(trainloader, active):
+            step(active, Evaluator.train_step, inputs, targets)
+
+        for evaluator in active:
+            evaluator.start_validation()
+        with torch.no_grad():
+            for inputs, targets in batches(validloader, active):
+                step(active, Evaluator.validation_step, inputs, targets)
+
+        for k, evaluator in enumerate(evaluators):
+            if evaluator in active and not evaluator.failed:
+                timed(evaluator, Evaluator.end_epoch, trace, network(k))
+        active = [evaluator for evaluator in evaluators if not evaluator.training_done]
+
+    if not packed:
+        evaluators[0].add_training_time(time.time() - start_time)
+
 
 if __name__ == '__main__':
     ev = Evaluator()
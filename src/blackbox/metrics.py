@@ -0,0 +1,78 @@
+# ------------------------------------------------------------------------------
+#  HyperNOMAD - Hyper-parameter optimization of deep neural networks with
+#               NOMAD.
+#
+#
+#
+#  This program is free software: you can redistribute it and/or modify it
+#  under the terms of the GNU Lesser General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or (at your
+#  option) any later version.
+#
+#  This program is distributed in the hope that it will be useful, but WITHOUT
+#  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+#  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+#  for more details.
+#
+#  You should have received a copy of the GNU Lesser General Public License
+#  along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+#  You can find information on the NOMAD software at www.gerad.ca/nomad
+# ------------------------------------------------------------------------------
+# Training metrics accumulated on the device and written once per epoch. Summing the losses and the number
+# of correct predictions in tensors avoids a synchronization with the device at each batch (loss.item()).
+# The epochs are written in a CSV trace (HYPERNOMAD_TRACE) collected by HyperNOMAD in traces.csv;
+# the curves are plotted offline with plot_traces.py.
+
+import time
+
+import torch
+
+TRACE_COLUMNS = ['epoch', 'train_loss', 'train_accuracy', 'val_loss', 'val_accuracy', 'learning_rate', 'time']
+
+
+class EpochMetrics(object):
+    """Sums of the loss and of the correct predictions of one epoch (training or validation)"""
+
+    def __init__(self, device):
+        self.__loss = torch.zeros((), device=device)
+        self.__correct = torch.zeros((), dtype=torch.long, device=device)
+        self.__total = 0
+        self.__nb_batches = 0
+
+    def add(self, loss, outputs, targets):
+        """Accumulate a batch without copying to the host"""
+        self.__loss += loss.detach()
+        self.__correct += outputs.detach().argmax(1).eq(targets).sum()
+        self.__total += targets.size(0)
+        self.__nb_batches += 1
+
+    def flush(self):
+        """Mean loss and accuracy (%) of the epoch (one synchronization)"""
+        loss, correct = torch.stack([self.__loss.double(), self.__correct.double()]).tolist()
+        mean_loss = loss / max(self.__nb_batches, 1)
+        accuracy = 100. * correct / max(self.__total, 1)
+        return mean_loss, accuracy
+
+
+class TraceWriter(object):
+    """One line per epoch in a CSV file without header (nothing is written if the file name is None).
+    The networks trained together are given by their position at the start of the line."""
+
+    def __init__(self, file_name):
+        self.__file = open(file_name, 'w') if file_name else None
+        self.__start = time.time()
+
+    def write(self, epoch, train_loss, train_accuracy, val_loss, val_accuracy, learning_rate, network=None):
+        if self.__file is None:
+            return
+        values = [epoch, train_loss, train_accuracy, val_loss, val_accuracy, learning_rate, time.time() - self.__start]
+        if network is not None:
+            values = [network] + values
+        self.__file.write(','.join(repr(value) for value in values) + '\n')
+        self.__file.flush()
+
+    def close(self):
+        if self.__file is not None:
+            self.__file.close()
+            self.__file = None
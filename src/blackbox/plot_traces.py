@@ -0,0 +1,66 @@
+# ------------------------------------------------------------------------------
+#  HyperNOMAD - Hyper-parameter optimization of deep neural networks with
+#               NOMAD.
+#
+#
+#
+#  This program is free software: you can redistribute it and/or modify it
+#  under the terms of the GNU Lesser General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or (at your
+#  option) any later version.
+#
+#  This program is distributed in the hope that it will be useful, but WITHOUT
+#  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+#  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+#  for more details.
+#
+#  You should have received a copy of the GNU Lesser General Public License
+#  along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+#  You can find information on the NOMAD software at www.gerad.ca/nomad
+# ------------------------------------------------------------------------------
+# Offline plot of the training and validation accuracies of evaluations recorded by HyperNOMAD in traces.csv
+# (the evaluation number is the line of the evaluation in history.txt).
+# Usage: plot_traces.py TRACES_FILE [EVALUATION ...] [-o FIGURE_FILE]
+
+import argparse
+import csv
+
+import matplotlib
+import matplotlib.pyplot as plt
+
+parser = argparse.ArgumentParser(description='Plot the training traces of HyperNOMAD')
+parser.add_argument('traces_file')
+parser.add_argument('evaluations', nargs='*', type=int, help='evaluations to plot (all by default)')
+parser.add_argument('-o', dest='figure_file', help='save the figure instead of showing it')
+args = parser.parse_args()
+
+if args.figure_file:
+    matplotlib.use('Agg')
+
+traces = {}
+with open(args.traces_file) as f:
+    for row in csv.DictReader(f):
+        evaluation = int(row['evaluation'])
+        if args.evaluations and evaluation not in args.evaluations:
+            continue
+        traces.setdefault(evaluation, []).append(row)
+
+fig = plt.figure()
+ax1 = fig.add_subplot(111)
+ax1.set_title('Training and validation accuracies')
+ax1.set_xlabel('Number of epochs')
+ax1.set_ylabel('Accuracies')
+
+for evaluation in sorted(traces):
+    epochs = [int(row['epoch']) for row in traces[evaluation]]
+    line, = ax1.plot(epochs, [float(row['val_accuracy']) for row in traces[evaluation]],
+                     label='Validation accuracy (evaluation %d)' % evaluation)
+    ax1.plot(epochs, [float(row['train_accuracy']) for row in traces[evaluation]], linestyle='--',
+             color=line.get_color(), label='Training accuracy (evaluation %d)' % evaluation)
+ax1.legend(loc='best')
+
+if args.figure_file:
+    fig.savefig(args.figure_file)
+else:
+    plt.show()
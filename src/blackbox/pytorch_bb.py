@@ -37,27 +37,56 @@ hypernomad_home = os.environ.get('HYPERNOMAD_HOME')
 blackbox_path = hypernomad_home + '/src/blackbox/blackbox.py'
 
 fin = open(sys.argv[2], 'r')
-Lin = fin.readlines()
+Lin = [line for line in fin.readlines() if line.strip()]
 Xin = Lin[0].split()
 fin.close()
 
 syst_cmd = 'OMP_NUM_THREADS=3 python ' + blackbox_path + ' ' + sys.argv[1] + ' '
 
+# Several points (one per line, CO_SCHEDULING): the networks are trained together
+nb_points = len(Lin)
+if nb_points > 1:
+    syst_cmd += '--pack ' + sys.argv[2] + ' '
+else:
+    for i in range(len(Xin)):
+        syst_cmd += str(Xin[i]) + ' '
 
-for i in range(len(Xin)):
-    syst_cmd += str(Xin[i]) + ' '
-
-syst_cmd += '> out.txt 2>&1'
+# Output file of this launch: the workers of HyperNOMAD run several blackboxes at once in the same directory
+out_file = 'out.%d.txt' % os.getpid()
+syst_cmd += '> ' + out_file + ' 2>&1'
 os.system(syst_cmd)
 
-fout = open('out.txt', 'r')
+# Outputs requested by HyperNOMAD after the objective (SECOND_OBJECTIVE, MAX_LATENCY)
+outputs = []
+if 'HYPERNOMAD_OUTPUTS' in os.environ:
+    outputs = os.environ.get('HYPERNOMAD_OUTPUTS').split(',')
+
+fout = open(out_file, 'r')
 Lout = fout.readlines()
+fout.close()
+os.remove(out_file)
+
+# Outputs of each network (prefixed by "> Network k:" for several points)
+accuracy = [None] * nb_points
+values_of_outputs = [{} for k in range(nb_points)]
 for line in Lout:
+    k = 0
+    if line.startswith('> Network '):
+        k = int(line.split()[2].rstrip(':'))
+        line = '>' + line.split(':', 1)[1]
     if "Final accuracy" in line:
-        tmp = line.split()
-        print('-' + str(tmp[3]))
-        fout.close()
-        exit()
+        accuracy[k] = line.split()[3]
+    if "Training time" in line:
+        values_of_outputs[k]['TRAINING_TIME'] = line.split()[3]
+    if "Inference latency" in line:
+        values_of_outputs[k]['LATENCY'] = line.split()[3]
 
-print('Inf')
-fout.close()
+# One line per point
+for k in range(nb_points):
+    if accuracy[k] is None:
+        print('Inf')
+        continue
+    values = ['-' + str(accuracy[k])]
+    for name in outputs:
+        values += [str(values_of_outputs[k].get(name, 'Inf'))]
+    print(' '.join(values))
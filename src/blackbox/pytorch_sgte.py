@@ -47,17 +47,36 @@ syst_cmd = 'OMP_NUM_THREADS=3 python ' + blackbox_path + ' ' + sys.argv[1] + ' '
 for i in range(len(Xin)):
     syst_cmd += str(Xin[i]) + ' '
 
-syst_cmd += '> out.txt 2>&1'
+# Output file of this launch: the workers of HyperNOMAD run several blackboxes at once in the same directory
+out_file = 'out.%d.txt' % os.getpid()
+syst_cmd += '> ' + out_file + ' 2>&1'
 os.system(syst_cmd)
 
-fout = open('out.txt', 'r')
+# Outputs requested by HyperNOMAD after the objective (SECOND_OBJECTIVE, MAX_LATENCY)
+outputs = []
+if 'HYPERNOMAD_OUTPUTS' in os.environ:
+    outputs = os.environ.get('HYPERNOMAD_OUTPUTS').split(',')
+
+fout = open(out_file, 'r')
 Lout = fout.readlines()
+fout.close()
+os.remove(out_file)
+
+accuracy = None
+values_of_outputs = {}
 for line in Lout:
     if "Final accuracy" in line:
-        tmp = line.split()
-        print('-' + str(tmp[3]))
-        fout.close()
-        exit()
+        accuracy = line.split()[3]
+    if "Training time" in line:
+        values_of_outputs['TRAINING_TIME'] = line.split()[3]
+    if "Inference latency" in line:
+        values_of_outputs['LATENCY'] = line.split()[3]
 
-print('Inf')
-fout.close()
+if accuracy is None:
+    print('Inf')
+    exit()
+
+values = ['-' + str(accuracy)]
+for name in outputs:
+    values += [str(values_of_outputs.get(name, 'Inf'))]
+print(' '.join(values))
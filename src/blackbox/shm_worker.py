@@ -0,0 +1,111 @@
+# ------------------------------------------------------------------------------
+#  HyperNOMAD - Hyper-parameter optimization of deep neural networks with
+#               NOMAD.
+#
+#
+#
+#  This program is free software: you can redistribute it and/or modify it
+#  under the terms of the GNU Lesser General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or (at your
+#  option) any later version.
+#
+#  This program is distributed in the hope that it will be useful, but WITHOUT
+#  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+#  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+#  for more details.
+#
+#  You should have received a copy of the GNU Lesser General Public License
+#  along with this program. If not, see <http://www.gnu.org/licenses/>.
+#
+#  You can find information on the NOMAD software at www.gerad.ca/nomad
+# ------------------------------------------------------------------------------
+# Persistent worker evaluating the points given by HyperNOMAD in a slot of shared memory
+# (BB_TRANSFER SHARED_MEMORY). The points and the outputs are doubles: there is no input file,
+# no command line and no text conversion. Usage: shm_worker.py DATASET SHARED_MEMORY_NAME SLOT DRIVER_PID
+#
+# Layout of the shared memory (native byte order, see sharedMemoryRing.hpp):
+#   header: magic, number of slots, maximum dimension, maximum number of outputs (4 x uint32)
+#   slot:   state, dimension, number of outputs, seed (4 x int32), then maximum dimension + maximum number of outputs doubles
+
+import mmap
+import os
+import struct
+import sys
+import time
+
+import blackbox
+
+MAGIC = 0x484e5348
+FREE, POINT_READY, RUNNING, DONE, FAILED, STOP = range(6)
+
+if len(sys.argv) != 5:
+    print('Usage of shm_worker.py: DATASET SHARED_MEMORY_NAME SLOT DRIVER_PID')
+    exit()
+
+dataset = sys.argv[1]
+name = sys.argv[2]
+slot = int(sys.argv[3])
+driver_pid = int(sys.argv[4])
+
+# Outputs requested by HyperNOMAD after the objective (SECOND_OBJECTIVE, MAX_LATENCY)
+outputs = [output for output in os.environ.get('HYPERNOMAD_OUTPUTS', '').split(',') if output]
+
+with open('/dev/shm/' + name.lstrip('/'), 'r+b') as f:
+    memory = mmap.mmap(f.fileno(), 0)
+
+magic, nb_slots, max_dimension, max_outputs = struct.unpack_from('=4I', memory, 0)
+if magic != MAGIC or slot >= nb_slots:
+    print('Invalid shared memory ' + name)
+    exit()
+
+offset = 16 + slot * (16 + 8 * (max_dimension + max_outputs))
+values_offset = offset + 16
+outputs_offset = values_offset + 8 * max_dimension
+
+
+def driver_is_alive():
+    try:
+        os.kill(driver_pid, 0)
+    except OSError:
+        return False
+    return True
+
+
+def set_state(state):
+    struct.pack_into('=i', memory, offset, state)
+
+
+while True:
+    state = struct.unpack_from('=i', memory, offset)[0]
+    if state == STOP or not driver_is_alive():
+        break
+    if state != POINT_READY:
+        time.sleep(0.01)
+        continue
+
+    set_state(RUNNING)
+    dimension, nb_outputs, seed = struct.unpack_from('=3i', memory, offset + 4)
+    x = struct.unpack_from('=%dd' % dimension, memory, values_offset)
+
+    if seed >= 0:
+        blackbox.set_seed(seed)
+
+    try:
+        # Best model of the worker: one file per slot (the workers share the directory)
+        results = blackbox.evaluate(dataset, x, outputs, 'best_model.%s.%d' % (name.lstrip('/'), slot))
+    except Exception as e:
+        print('> Evaluation failed: ' + str(e))
+        results = None
+
+    if results is None:
+        set_state(FAILED)
+        continue
+
+    # Same outputs as pytorch_bb.py (the state is written last)
+    values = [-results['accuracy']] + [results.get(output, float('inf')) for output in outputs]
+    values = values[:nb_outputs] + [float('inf')] * (nb_outputs - len(values))
+    struct.pack_into('=%dd' % nb_outputs, memory, outputs_offset, *values)
+    sys.stdout.flush()
+    set_state(DONE)
+
+memory.close()
@@ -0,0 +1,209 @@
+//
+//  architecture.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "architecture.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void Architecture::getImageInfo ( const std::string & dataset , int & imageSize , int & inputChannels , int & nbClasses )
+{
+    imageSize = 32;
+    inputChannels = 3;
+    nbClasses = 10;
+    
+    if ( dataset == "MINIMNIST" || dataset == "MNIST" || dataset == "Fashion-MNIST" || dataset == "KMNIST" || dataset == "EMNIST" )
+    {
+        imageSize = 28;
+        inputChannels = 1;
+    }
+    else if ( dataset == "CIFAR100" )
+        nbClasses = 100;
+    else if ( dataset == "STL10" )
+        imageSize = 96;
+}
+
+Architecture::Architecture ( const std::vector<HyperParameters::BlockLayout> & layout , const std::string & dataset , const NOMAD::Point & x ) :
+_known ( false ),
+_batchSize ( 1 ),
+_dimension ( static_cast<size_t>( x.size() ) )
+{
+    getImageInfo( dataset , _imageSize , _inputChannels , _nbClasses );
+    
+    bool hasConv = false , hasFull = false;
+    
+    int index = 0;
+    for ( const auto & block : layout )
+    {
+        if ( index >= x.size() || ! x[index].is_defined() )
+            return;
+        
+        int head = x[index++].round();
+        
+        size_t nbGroups = ( block.groupSize == 0 ) ? 0 : 1;
+        if ( block.multipleGroups )
+            nbGroups = ( head > 0 ) ? static_cast<size_t>( head ) : 0;
+        
+        if ( index + static_cast<int>( nbGroups * block.groupSize ) > x.size() )
+            return;
+        
+        if ( block.headSearchName == "NUM_CON_LAYERS" && block.groupSize == 5 )
+        {
+            hasConv = true;
+            for ( size_t g = 0 ; g < nbGroups ; g++ , index += 5 )
+                _convLayers.push_back( { x[index].round() , x[index+1].round() , x[index+2].round() , x[index+3].round() , x[index+4].round() } );
+        }
+        else if ( block.headSearchName == "NUM_FC_LAYERS" && block.groupSize == 1 )
+        {
+            hasFull = true;
+            for ( size_t g = 0 ; g < nbGroups ; g++ , index++ )
+                _fullLayers.push_back( x[index].round() );
+        }
+        else
+        {
+            if ( block.headSearchName == "BATCH_SIZE" )
+                _batchSize = head;
+            index += static_cast<int>( nbGroups * block.groupSize );
+        }
+    }
+    
+    _known = ( index == x.size() && hasConv && hasFull );
+}
+
+double Architecture::getFlops ( void ) const
+{
+    if ( ! _known )
+        return static_cast<double>( _dimension );
+    
+    double flops = 0;
+    
+    // Convolutions (multiply-add counted as 2 operations) followed by max pooling
+    double size = _imageSize;
+    double inChannels = _inputChannels;
+    for ( const auto & c : _convLayers )
+    {
+        size = std::floor( ( size + 2.0 * c.padding - c.kernel ) / std::max( c.stride , 1 ) ) + 1;
+        if ( size < 1 )
+            size = 1;
+        flops += 2.0 * c.kernel * c.kernel * inChannels * c.outChannels * size * size;
+        size = std::max( std::floor( size / std::max( c.pooling , 1 ) ) , 1.0 );
+        inChannels = c.outChannels;
+    }
+    
+    // Full layers and classifier
+    double inSize = inChannels * size * size;
+    for ( int n : _fullLayers )
+    {
+        flops += 2.0 * inSize * n;
+        inSize = n;
+    }
+    flops += 2.0 * inSize * _nbClasses;
+    
+    return flops;
+}
+
+double Architecture::getNbParameters ( void ) const
+{
+    if ( ! _known )
+        return 0;
+    
+    double nbParameters = 0;
+    
+    // Convolution (weights and bias) followed by a batch normalization
+    double size = _imageSize;
+    double inChannels = _inputChannels;
+    for ( const auto & c : _convLayers )
+    {
+        nbParameters += static_cast<double>( c.kernel ) * c.kernel * inChannels * c.outChannels + 3.0 * c.outChannels;
+        size = std::floor( ( size + 2.0 * c.padding - c.kernel ) / std::max( c.stride , 1 ) ) + 1;
+        size = std::max( std::floor( size / std::max( c.pooling , 1 ) ) , 1.0 );
+        inChannels = c.outChannels;
+    }
+    
+    // Linear layers followed by a batch normalization
+    double inSize = inChannels * size * size;
+    for ( int n : _fullLayers )
+    {
+        nbParameters += inSize * n + 3.0 * n;
+        inSize = n;
+    }
+    nbParameters += inSize * _nbClasses + 3.0 * _nbClasses;
+    
+    return nbParameters;
+}
+
+double Architecture::getTrainingMemory ( void ) const
+{
+    if ( ! _known )
+        return 0;
+    
+    // Activations of one image: convolution, dropout and batch normalization outputs (ReLU in place), then pooling
+    double size = _imageSize;
+    double activations = static_cast<double>( _inputChannels ) * size * size;
+    for ( const auto & c : _convLayers )
+    {
+        size = std::max( std::floor( ( size + 2.0 * c.padding - c.kernel ) / std::max( c.stride , 1 ) ) + 1 , 1.0 );
+        activations += 3.0 * c.outChannels * size * size;
+        size = std::max( std::floor( size / std::max( c.pooling , 1 ) ) , 1.0 );
+        activations += static_cast<double>( c.outChannels ) * size * size;
+    }
+    for ( int n : _fullLayers )
+        activations += 3.0 * n;
+    activations += 2.0 * _nbClasses;
+    
+    const double bytesPerValue = 4;
+    return bytesPerValue * ( 4.0 * getNbParameters() + static_cast<double>( _batchSize ) * activations );
+}
+
+bool Architecture::checkShapes ( std::string & error ) const
+{
+    if ( ! _known )
+        return true;
+    
+    int size = _imageSize;
+    for ( size_t i = 0 ; i < _convLayers.size() ; i++ )
+    {
+        const ConvLayer & c = _convLayers[i];
+        if ( c.outChannels < 1 || c.kernel < 1 || c.stride < 1 || c.pooling < 1 )
+        {
+            error = "invalid parameters for convolution layer " + std::to_string( i + 1 );
+            return false;
+        }
+        
+        int padded = size + 2 * c.padding - c.kernel;
+        if ( padded < 0 )
+        {
+            error = "kernel larger than the image (" + std::to_string( size ) + ") at convolution layer " + std::to_string( i + 1 );
+            return false;
+        }
+        size = padded / c.stride + 1;
+        
+        size /= c.pooling;
+        if ( size < 1 )
+        {
+            error = "pooling larger than the image at convolution layer " + std::to_string( i + 1 );
+            return false;
+        }
+    }
+    
+    for ( size_t i = 0 ; i < _fullLayers.size() ; i++ )
+    {
+        if ( _fullLayers[i] < 1 )
+        {
+            error = "invalid size for full layer " + std::to_string( i + 1 );
+            return false;
+        }
+    }
+    
+    if ( _batchSize < 1 )
+    {
+        error = "invalid batch size";
+        return false;
+    }
+    
+    return true;
+}
@@ -0,0 +1,92 @@
+//
+//  architecture.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __ARCHITECTURE__
+#define __ARCHITECTURE__
+
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+
+// Network given by a point of the default search space (Pytorch blackbox). The blocks are found
+// with the search names NUM_CON_LAYERS, NUM_FC_LAYERS and BATCH_SIZE. For another schema, the
+// architecture is not known and the size of the point is used as a measure of the network size.
+class Architecture
+{
+public:
+    
+    struct ConvLayer
+    {
+        int outChannels;
+        int kernel;
+        int stride;
+        int padding;
+        int pooling;
+    };
+    
+private:
+    
+    bool _known;
+    
+    std::vector<ConvLayer> _convLayers;
+    std::vector<int> _fullLayers;
+    int _batchSize;
+    
+    // Images of the dataset (same as datahandler.py)
+    int _imageSize;
+    int _inputChannels;
+    int _nbClasses;
+    
+    size_t _dimension;
+    
+public:
+    
+    Architecture ( const std::vector<HyperParameters::BlockLayout> & layout , const std::string & dataset , const NOMAD::Point & x );
+    
+    bool isKnown ( void ) const { return _known; }
+    
+    const std::vector<ConvLayer> & getConvLayers ( void ) const { return _convLayers; }
+    const std::vector<int> & getFullLayers ( void ) const { return _fullLayers; }
+    int getBatchSize ( void ) const { return _batchSize; }
+    
+    // Floating point operations of a forward pass for one image (size of the point if not known)
+    double getFlops ( void ) const;
+    
+    // Number of trainable parameters of the network (weights, biases and batch normalizations)
+    double getNbParameters ( void ) const;
+    
+    // Estimation of the memory used for training with the batch size (bytes, single precision): parameters with
+    // their gradients and two optimizer states, and the activations kept for the backward pass
+    double getTrainingMemory ( void ) const;
+    
+    // Shape propagation as done by neural_net.py: the image size must stay positive after each convolution
+    // and each pooling. Return false with the reason if the network cannot be built (true if not known).
+    bool checkShapes ( std::string & error ) const;
+    
+    static void getImageInfo ( const std::string & dataset , int & imageSize , int & inputChannels , int & nbClasses );
+    
+};
+
+#endif
@@ -0,0 +1,182 @@
+//
+//  askTell.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "askTell.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+AskTell::AskTell ( std::shared_ptr<Campaign> campaign ) :
+_campaign ( std::move( campaign ) ),
+_layout ( _campaign->getHyperParameters().getBlockLayout() ),
+_nbOutputs ( _campaign->getHyperParameters().getBbOutputType().size() - _campaign->getHyperParameters().getSizeOutputs().size() ),
+_started ( false ),
+_over ( false ),
+_stopping ( false )
+{
+    _campaign->setCallback( [this]( const NOMAD::Point & x , NOMAD::Point & outputs , int seed ) { return evaluate( x , outputs , seed ); } );
+}
+
+AskTell::~AskTell ( void )
+{
+    {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        _stopping = true;
+    }
+    _outputs.notify_all();
+    
+    if ( _thread.joinable() )
+        _thread.join();
+    
+    // The callback refers to this object: the campaign can outlive it (shared)
+    _campaign->releaseCallback();
+}
+
+bool AskTell::evaluate ( const NOMAD::Point & x , NOMAD::Point & outputs , int seed )
+{
+    std::unique_lock<std::mutex> lock ( _mutex );
+    if ( _stopping )
+        return false;
+    
+    _pending.push_back( { x , seed , false , false , NOMAD::Point() } );
+    auto pending = std::prev( _pending.end() );
+    _newPoints.notify_all();
+    
+    _outputs.wait( lock , [this,pending]() { return pending->told || _stopping; } );
+    
+    bool success = ( pending->told && pending->outputs.size() == static_cast<int>( _nbOutputs ) );
+    if ( success )
+    {
+        for ( int j = 0 ; j < outputs.size() && j < pending->outputs.size() ; j++ )
+            outputs[j] = pending->outputs[j];
+    }
+    _pending.erase( pending );
+    
+    return success;
+}
+
+void AskTell::run ( void )
+{
+    std::exception_ptr error;
+    try
+    {
+        _campaign->run();
+    }
+    catch ( ... )
+    {
+        error = std::current_exception();
+    }
+    
+    std::lock_guard<std::mutex> lock ( _mutex );
+    _error = error;
+    _over = true;
+    _newPoints.notify_all();
+}
+
+std::vector<AskTell::Block> AskTell::getBlocks ( const NOMAD::Point & x ) const
+{
+    std::vector<Block> blocks;
+    
+    int index = 0;
+    for ( const auto & layout : _layout )
+    {
+        if ( index >= x.size() )
+            break;
+        
+        Block block;
+        block.name = layout.name;
+        block.headSearchName = layout.headSearchName;
+        block.head = x[index++];
+        block.searchNames = layout.searchNames;
+        
+        int head = block.head.round();
+        size_t nbGroups = ( layout.groupSize == 0 ) ? 0 : 1;
+        if ( layout.multipleGroups )
+            nbGroups = ( head > 0 ) ? static_cast<size_t>( head ) : 0;
+        
+        for ( size_t g = 0 ; g < nbGroups && index + static_cast<int>( layout.groupSize ) <= x.size() ; g++ )
+        {
+            std::vector<NOMAD::Double> group;
+            for ( size_t k = 0 ; k < layout.groupSize ; k++ )
+                group.push_back( x[index++] );
+            block.groups.push_back( group );
+        }
+        blocks.push_back( block );
+    }
+    return blocks;
+}
+
+std::vector<AskTell::Request> AskTell::ask ( size_t n , double timeout )
+{
+    std::unique_lock<std::mutex> lock ( _mutex );
+    
+    if ( ! _started )
+    {
+        _started = true;
+        _thread = std::thread( [this]() { run(); } );
+    }
+    
+    auto ready = [this]()
+    {
+        return _over || std::any_of( _pending.begin() , _pending.end() , []( const Pending & p ) { return ! p.asked; } );
+    };
+    if ( timeout < 0 )
+        _newPoints.wait( lock , ready );
+    else
+        _newPoints.wait_for( lock , std::chrono::duration<double>( timeout ) , ready );
+    
+    if ( _error )
+    {
+        std::exception_ptr error = _error;
+        _error = nullptr;
+        std::rethrow_exception( error );
+    }
+    
+    std::vector<Request> requests;
+    for ( auto & pending : _pending )
+    {
+        if ( requests.size() >= n )
+            break;
+        if ( pending.asked )
+            continue;
+        
+        pending.asked = true;
+        requests.push_back( { pending.x , pending.seed , getBlocks( pending.x ) } );
+    }
+    return requests;
+}
+
+bool AskTell::tell ( const NOMAD::Point & x , int seed , const NOMAD::Point & outputs )
+{
+    if ( outputs.size() != 0 && outputs.size() != static_cast<int>( _nbOutputs ) )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "AskTell: the number of outputs told is not the number of outputs of the blackbox" );
+    
+    std::lock_guard<std::mutex> lock ( _mutex );
+    for ( auto & pending : _pending )
+    {
+        if ( ! pending.asked || pending.told || pending.seed != seed || pending.x.size() != x.size() || pending.x != x )
+            continue;
+        
+        pending.told = true;
+        pending.outputs = outputs;
+        _outputs.notify_all();
+        return true;
+    }
+    return false;
+}
+
+size_t AskTell::getNbInProgress ( void ) const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    return std::count_if( _pending.begin() , _pending.end() , []( const Pending & p ) { return p.asked && ! p.told; } );
+}
+
+bool AskTell::isOver ( void ) const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    return _over;
+}
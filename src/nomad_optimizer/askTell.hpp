@@ -0,0 +1,140 @@
+//
+//  askTell.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __ASKTELL__
+#define __ASKTELL__
+
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+#include "campaign.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Campaign driven by an external scheduler: HyperNOMAD proposes points (ask) and receives their outputs (tell)
+// instead of evaluating them. The campaign runs in a thread of its own at the first ask: its evaluation callback
+// waits for the outputs of each point. The points of a block are asked together and the results can be told in any
+// order: Mads goes on when all the points of the block are told, as with the workers (the history is in the order
+// of the blocks). At most BB_MAX_BLOCK_SIZE points are asked and not told at a time.
+// The output files are set on the campaign before the first ask (see Campaign::setOutputFiles). The campaign can be
+// queried during the run (Campaign::getIncumbent, getHistory, getStats).
+class AskTell
+{
+public:
+    
+    // Values of a point for a block of the search space (a group per layer)
+    struct Block
+    {
+        std::string name;
+        std::string headSearchName;
+        NOMAD::Double head;
+        std::vector<std::string> searchNames;
+        std::vector<std::vector<NOMAD::Double>> groups;
+    };
+    
+    // A point to evaluate with the seed of the blackbox (negative if none, see REPLICATIONS)
+    struct Request
+    {
+        NOMAD::Point x;
+        int seed;
+        std::vector<Block> blocks;
+    };
+    
+private:
+    
+    // A point given to the callback of the campaign
+    struct Pending
+    {
+        NOMAD::Point x;
+        int seed;
+        bool asked;
+        bool told;
+        NOMAD::Point outputs;
+    };
+    
+    std::shared_ptr<Campaign> _campaign;
+    std::vector<HyperParameters::BlockLayout> _layout;
+    size_t _nbOutputs;
+    
+    std::thread _thread;
+    bool _started;
+    bool _over;
+    bool _stopping;
+    std::exception_ptr _error;
+    
+    // Stable addresses: each callback waits for its own point
+    std::list<Pending> _pending;
+    
+    mutable std::mutex _mutex;
+    std::condition_variable _newPoints; // new points or end of the campaign
+    std::condition_variable _outputs;   // outputs told
+    
+    // Callback of the campaign (thread of a worker)
+    bool evaluate ( const NOMAD::Point & x , NOMAD::Point & outputs , int seed );
+    
+    // Thread of the campaign
+    void run ( void );
+    
+    std::vector<Block> getBlocks ( const NOMAD::Point & x ) const;
+    
+public:
+    
+    // The callback of the campaign is set: the campaign must not be started
+    explicit AskTell ( std::shared_ptr<Campaign> campaign );
+    
+    // The points not told are failed evaluations: the campaign goes to its end without evaluating points.
+    // The callback is released and the campaign is over (see Campaign::releaseCallback).
+    ~AskTell ( void );
+    
+    AskTell ( const AskTell & ) = delete;
+    AskTell & operator= ( const AskTell & ) = delete;
+    
+    // Up to n points not asked yet. Wait for at least one point at most timeout seconds (until a point is available
+    // or the end of the campaign if negative). An empty vector is returned when the campaign is over (see isOver).
+    // An exception of the campaign is thrown again here.
+    std::vector<Request> ask ( size_t n , double timeout = -1 );
+    
+    // Outputs of the blackbox for an asked point and seed (see Campaign::Callback), empty if the evaluation failed.
+    // The replications of a point (REPLICATIONS) are asked with the same point and different seeds.
+    // Return false if the point is not waiting for its outputs (not asked, already told or campaign over).
+    bool tell ( const NOMAD::Point & x , int seed , const NOMAD::Point & outputs );
+    
+    bool tell ( const Request & request , const NOMAD::Point & outputs ) { return tell( request.x , request.seed , outputs ); }
+    
+    // Number of points asked and not told
+    size_t getNbInProgress ( void ) const;
+    
+    bool isOver ( void ) const;
+    
+    Campaign & getCampaign ( void ) { return *_campaign; }
+};
+
+#endif
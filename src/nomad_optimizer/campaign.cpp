@@ -0,0 +1,373 @@
+//
+//  campaign.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "campaign.hpp"
+#include "hyperExtendedPoll.hpp"
+#include "warmStart.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+Campaign::Campaign ( std::shared_ptr<HyperParameters> hyperParameters , const NOMAD::Display & out , std::shared_ptr<WorkerPool> workerPool , std::shared_ptr<EvaluationCache> cache ) :
+_hyperParameters ( std::move( hyperParameters ) ),
+_bbot ( _hyperParameters->getBbOutputType() ),
+_out ( out ),
+_p ( _out ),
+_ev ( _p , *_hyperParameters , ( workerPool ) ? workerPool : std::make_shared<WorkerPool>( _hyperParameters->getBbMaxBlockSize() ) , std::move( cache ) ),
+_outputFiles ( false ),
+_started ( false ),
+_over ( false ),
+_nbMadsRuns ( 0 ),
+_nbSteps ( 0 ),
+_wallTime ( 0 ),
+_stopType ( NOMAD::NO_STOP )
+{
+    init();
+}
+
+Campaign::Campaign ( const std::string & hyperParamFileName , const std::string & pytorchBB , const std::string & pytorchSGTE , const NOMAD::Display & out , std::shared_ptr<WorkerPool> workerPool , std::shared_ptr<EvaluationCache> cache ) :
+Campaign ( std::make_shared<HyperParameters>( hyperParamFileName , pytorchBB , pytorchSGTE ) , out , std::move( workerPool ) , std::move( cache ) )
+{
+}
+
+void Campaign::init ( void )
+{
+    // Several starting points (X0 given several times): X0 is evaluated with the others and the best one is the poll center
+    if ( ! _hyperParameters->getOtherX0s().empty() )
+    {
+        _startingPoints.push_back( _hyperParameters->getValues( ValueType::CURRENT_VALUE ) );
+        _startingPoints.insert( _startingPoints.end() , _hyperParameters->getOtherX0s().begin() , _hyperParameters->getOtherX0s().end() );
+    }
+    
+    // The histories of previous campaigns are read before the history of this campaign is written (it can be the same file)
+    if ( ! _hyperParameters->getWarmStartFiles().empty() )
+    {
+        WarmStart warmStart ( _hyperParameters->getBlockLayout() , _hyperParameters->getWarmStartFiles() );
+        std::vector<NOMAD::Point> warmStartPoints = warmStart.getBestPoints( *_hyperParameters , _hyperParameters->getWarmStartPoints() );
+        _startingPoints.insert( _startingPoints.end() , warmStartPoints.begin() , warmStartPoints.end() );
+        
+        if ( _hyperParameters->getHyperDisplay() > 0 )
+            std::cout << "Warm start: " << warmStartPoints.size() << " points selected from " << warmStart.size() << " evaluations in " << warmStart.getNbFiles() << " files" << std::endl;
+    }
+    
+    // Bi-objective: the non dominated points are kept during the optimization (initial design included)
+    if ( _hyperParameters->getNbObjectives() > 1 )
+    {
+        _paretoArchive = std::make_shared<ParetoArchive>();
+        _ev.setParetoArchive( _paretoArchive , "" );
+    }
+}
+
+void Campaign::setCallback ( Callback callback )
+{
+    if ( _started )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "The callback of a campaign must be set before the first step" );
+    
+    _ev.setCallback( std::move( callback ) );
+}
+
+void Campaign::releaseCallback ( void )
+{
+    _ev.setCallback( []( const NOMAD::Point & , NOMAD::Point & , int ) { return false; } );
+    _over = true;
+}
+
+void Campaign::setOutputFiles ( const std::string & filePrefix )
+{
+    if ( _started )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "The output files of a campaign must be set before the first step" );
+    
+    _outputFiles = true;
+    _filePrefix = filePrefix;
+    
+    // The history is written by the evaluator without loss of precision (initial design included)
+    _ev.setHistoryFile( filePrefix + "history.txt" );
+    
+    // Evaluations stopped after their time budget (at least the budget)
+    if ( _hyperParameters->getMaxEvalTime() > 0 )
+        _ev.setCensoredFile( filePrefix + "censored.txt" );
+    
+    // Metrics of each epoch of the trainings (plotted offline with src/blackbox/plot_traces.py)
+    _ev.setTraceFile( filePrefix + "traces.csv" );
+    
+    // The non dominated points are written during the optimization
+    if ( _paretoArchive )
+        _ev.setParetoArchive( _paretoArchive , filePrefix + "pareto.txt" );
+}
+
+int Campaign::getObjIndex ( const std::vector<NOMAD::bb_output_type> & bbot )
+{
+    return static_cast<int>( std::find( bbot.begin() , bbot.end() , NOMAD::OBJ ) - bbot.begin() );
+}
+
+int Campaign::findBest ( const std::vector<NOMAD::bb_output_type> & bbot , const std::vector<NOMAD::Point> & outputs )
+{
+    // Feasible for the constraints with the smallest objective (the first one with SECOND_OBJECTIVE)
+    const int objIndex = getObjIndex( bbot );
+    int best = -1;
+    NOMAD::Double bestF;
+    for ( size_t i = 0 ; i < outputs.size() ; i++ )
+    {
+        if ( outputs[i].size() != static_cast<int>( bbot.size() ) )
+            continue;
+        
+        const NOMAD::Double & f = outputs[i][objIndex];
+        bool feasible = true;
+        for ( size_t j = 0 ; j < bbot.size() ; j++ )
+        {
+            const NOMAD::Double & v = outputs[i][static_cast<int>(j)];
+            if ( HyperEvaluator::isConstraint( bbot[j] ) && v > 0 )
+                feasible = false;
+        }
+        
+        if ( feasible && f.is_defined() && ( ! bestF.is_defined() || f < bestF ) )
+        {
+            bestF = f;
+            best = static_cast<int>( i );
+        }
+    }
+    return best;
+}
+
+void Campaign::runInitialDesign ( void )
+{
+    std::vector<NOMAD::Point> design = _startingPoints;
+    
+    std::vector<NOMAD::Point> latinHypercube = _hyperParameters->getInitialDesign();
+    design.insert( design.end() , latinHypercube.begin() , latinHypercube.end() );
+    
+    std::vector<NOMAD::Point> outputs;
+    size_t nbEval = _ev.evaluate( design , outputs );
+    
+    int best = findBest( _bbot , outputs );
+    
+    if ( _hyperParameters->getHyperDisplay() > 0 )
+        std::cout << "Initial design: " << design.size() << " points, " << nbEval << " blackbox evaluations";
+    
+    if ( best < 0 )
+    {
+        if ( _hyperParameters->getHyperDisplay() > 0 )
+            std::cout << ", no feasible point. X0 is not changed." << std::endl;
+        return;
+    }
+    
+    if ( _hyperParameters->getHyperDisplay() > 0 )
+        std::cout << ", best objective " << outputs[best][getObjIndex( _bbot )] << std::endl;
+    
+    _hyperParameters->setX0( design[best] );
+}
+
+void Campaign::setParameters ( NOMAD::Parameters & p , size_t maxBbEval , bool statsFile ) const
+{
+    p.set_DISPLAY_DEGREE( static_cast<int>( _hyperParameters->getHyperDisplay() ) );
+    
+    p.set_DIMENSION( static_cast<int>(_hyperParameters->getDimension()) );
+    p.set_X0( _hyperParameters->getValues( ValueType::CURRENT_VALUE) );
+    p.set_BB_INPUT_TYPE( _hyperParameters->getTypes() );
+    p.set_LOWER_BOUND( _hyperParameters->getValues( ValueType::LOWER_BOUND ) );
+    p.set_UPPER_BOUND( _hyperParameters->getValues( ValueType::UPPER_BOUND ) );
+    
+    std::vector<size_t> indexFixedParams = _hyperParameters->getIndexFixedParams();
+    for ( auto i : indexFixedParams )
+        p.set_FIXED_VARIABLE( static_cast<int>(i) );
+    
+    // Each block forms a VARIABLE GROUP in Nomad
+    std::vector<std::set<int>> variableGroupsIndices = _hyperParameters->getVariableGroupsIndices();
+    
+    for ( auto aGroupIndices : variableGroupsIndices )
+        p.set_VARIABLE_GROUP( aGroupIndices );
+    
+    p.set_BB_OUTPUT_TYPE ( _hyperParameters->getBbOutputType() );
+    // A synthetic blackbox or a callback is evaluated in process (no executable)
+    if ( ! _ev.isInProcess() )
+    {
+        p.set_BB_EXE( _hyperParameters->getBB() );
+        
+        p.set_SGTE_EXE( _hyperParameters->getBB() , _hyperParameters->getSGTE() );
+    }
+    
+    p.set_LH_SEARCH(0 , static_cast<int>( _hyperParameters->getLhIterationSearch() ) );
+    
+    // BiMads does a sequence of single-objective runs: the budget is for all of them
+    if ( _hyperParameters->getNbObjectives() > 1 )
+        p.set_MULTI_OVERALL_BB_EVAL( static_cast<int>( maxBbEval ) );
+    else
+        p.set_MAX_BB_EVAL( static_cast<int>( maxBbEval ) );
+    
+    p.set_BB_MAX_BLOCK_SIZE( static_cast<int>( _hyperParameters->getBbMaxBlockSize() ) );
+    
+    p.set_EXTENDED_POLL_TRIGGER ( 10 , false );
+    
+    p.set_DISPLAY_STATS("bbe ( sol ) obj");
+    if ( statsFile )
+        p.set_STATS_FILE(_filePrefix + "stats.txt","bbe ( sol ) obj");
+    
+    // parameters validation:
+    p.check();
+}
+
+bool Campaign::runMads ( size_t maxBbEval )
+{
+    const bool biObjective = ( _hyperParameters->getNbObjectives() > 1 );
+    
+    // The first run has the parameters of the evaluator. A run after the first one has its own parameters
+    // (the structure of X0 can be different).
+    std::unique_ptr<NOMAD::Parameters> runParameters;
+    if ( _nbMadsRuns > 0 )
+        runParameters.reset( new NOMAD::Parameters ( _out ) );
+    NOMAD::Parameters & p = ( runParameters ) ? *runParameters : _p;
+    
+    setParameters( p , maxBbEval , _outputFiles && _nbMadsRuns == 0 );
+    
+    if ( _hyperParameters->getHyperDisplay() > 2 )
+    {
+        std::cout << std::endl
+        << NOMAD::open_block ( "Nomad parameters" ) << std::endl
+        << p
+        << NOMAD::close_block();
+    }
+    
+    // The evaluations with the structure of X0 are given to Nomad in its cache (used by the models).
+    // Not done with two objectives: f depends on the formulation of each BiMads run.
+    NOMAD::Cache nomadCache ( _out , NOMAD::TRUTH );
+    if ( ! biObjective )
+    {
+        for ( const Evaluation & evaluation : _ev.getEvaluations() )
+        {
+            if ( ! _hyperParameters->hasCurrentStructure( evaluation.x ) )
+                continue;
+            
+            NOMAD::Eval_Point * x = new NOMAD::Eval_Point ( evaluation.x.size() , evaluation.outputs.size() );
+            for ( int j = 0 ; j < evaluation.x.size() ; j++ )
+                (*x)[j] = evaluation.x[j];
+            x->set_signature( p.get_signature() );
+            x->set_bb_output( evaluation.outputs );
+            x->set_eval_status( NOMAD::EVAL_OK );
+            _ev.compute_f( *x );
+            _ev.compute_h( *x );
+            
+            // The cache takes care of the point
+            nomadCache.insert( *x );
+        }
+    }
+    
+    // extended poll:
+    HyperExtendedPoll ep ( p , _hyperParameters );
+    
+    // algorithm creation and execution (BiMads with two objectives):
+    std::unique_ptr<HyperMultiObjEvaluator> multiObjEv;
+    if ( biObjective )
+        multiObjEv.reset( new HyperMultiObjEvaluator ( p , _ev ) );
+    
+    NOMAD::Mads mads ( p , ( biObjective ) ? static_cast<NOMAD::Evaluator*>( multiObjEv.get() ) : &_ev , &ep , &nomadCache , NULL );
+    
+    const size_t nbEvalBefore = _ev.getNbEval();
+    
+    // BiMads: multi_run solves the sequence of single-objective problems (MULTI_OVERALL_BB_EVAL)
+    NOMAD::stop_type stopType = ( biObjective ) ? mads.multi_run() : mads.run();
+    
+    _nbMadsRuns++;
+    {
+        std::lock_guard<std::mutex> lock ( _statsMutex );
+        _stopType = stopType;
+    }
+    
+    return ( _ev.getNbEval() - nbEvalBefore >= maxBbEval );
+}
+
+bool Campaign::step ( size_t maxBbEval )
+{
+    if ( _over )
+        return false;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    const size_t maxTotal = _hyperParameters->getMaxBbEval();
+    
+    // The initial design is done before setting X0 of Mads
+    bool designStep = false;
+    if ( ! _started )
+    {
+        _started = true;
+        if ( _hyperParameters->getInitialDesignSize() > 0 || ! _startingPoints.empty() )
+        {
+            runInitialDesign();
+            designStep = true;
+        }
+    }
+    
+    if ( ! designStep && _ev.getNbEval() < maxTotal )
+    {
+        // The evaluations of the initial design and of the previous runs are part of the budget
+        const size_t remaining = maxTotal - _ev.getNbEval();
+        const size_t budget = ( maxBbEval > 0 ) ? std::min( maxBbEval , remaining ) : remaining;
+        
+        // A run after the first one starts from the incumbent (and its structure) with a new mesh
+        Evaluation incumbent;
+        if ( _nbMadsRuns > 0 && getIncumbent( incumbent ) )
+            _hyperParameters->setX0( incumbent.x );
+        
+        // Mads stopped before the end of its budget (mesh, X0 failure, ...): a new run would do the same
+        if ( ! runMads( budget ) )
+            _over = true;
+    }
+    
+    if ( _ev.getNbEval() >= maxTotal )
+    {
+        _over = true;
+        
+        std::lock_guard<std::mutex> lock ( _statsMutex );
+        if ( _nbMadsRuns == 0 )
+            _stopType = NOMAD::MAX_BB_EVAL_REACHED;
+    }
+    
+    std::lock_guard<std::mutex> lock ( _statsMutex );
+    _nbSteps++;
+    _wallTime += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    
+    return ! _over;
+}
+
+NOMAD::stop_type Campaign::run ( void )
+{
+    while ( step() ) {}
+    
+    std::lock_guard<std::mutex> lock ( _statsMutex );
+    return _stopType;
+}
+
+bool Campaign::getIncumbent ( Evaluation & incumbent ) const
+{
+    std::vector<Evaluation> evaluations = _ev.getEvaluations();
+    
+    std::vector<NOMAD::Point> outputs;
+    for ( const Evaluation & evaluation : evaluations )
+        outputs.push_back( evaluation.outputs );
+    
+    int best = findBest( _bbot , outputs );
+    if ( best < 0 )
+        return false;
+    
+    incumbent = evaluations[best];
+    return true;
+}
+
+Campaign::Stats Campaign::getStats ( void ) const
+{
+    Stats stats;
+    stats.nbEval = _ev.getNbEval();
+    stats.nbSuccess = _ev.getNbEvaluations();
+    stats.nbRejected = _ev.getNbRejected();
+    stats.nbTimedOut = _ev.getNbTimedOut();
+    stats.nbReplications = _ev.getNbReplications();
+    
+    std::lock_guard<std::mutex> lock ( _statsMutex );
+    stats.nbSteps = _nbSteps;
+    stats.wallTime = _wallTime;
+    stats.stopType = _stopType;
+    return stats;
+}
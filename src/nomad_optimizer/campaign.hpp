@@ -0,0 +1,156 @@
+//
+//  campaign.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __CAMPAIGN__
+#define __CAMPAIGN__
+
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+#include "hyperEvaluator.hpp"
+#include "paretoArchive.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Optimization for a single hyperparameters file in the calling process (hypernomad.exe runs its campaigns with it).
+// The campaign starts with the starting points (X0 given several times, WARM_START) and the initial design, then Mads
+// runs with the extended poll on the structures. The points are evaluated by the blackbox of the hyperparameters
+// or by a callback of the host process.
+// A step is the initial design (first step only) or a Mads run from the incumbent for a number of evaluations: a
+// campaign can be run in several steps and queried between them. A Mads run after the first one starts with the
+// structure of the incumbent and a new mesh (the evaluations already done are found in the cache of evaluations).
+// The output files (history.txt, stats.txt, ...) are written only if a prefix is given. stats.txt is the
+// statistics of the first Mads run.
+// The history, the incumbent and the statistics can be read by another thread during a step (not the Pareto archive).
+class Campaign
+{
+public:
+    
+    typedef HyperEvaluator::Callback Callback;
+    typedef HyperEvaluator::Evaluation Evaluation;
+    
+    struct Stats
+    {
+        size_t nbEval;          // Evaluations counted in MAX_BB_EVAL (initial design included)
+        size_t nbSuccess;       // Successful evaluations (history)
+        size_t nbRejected;      // Points rejected without launching the blackbox
+        size_t nbTimedOut;      // Evaluations stopped after their time budget (MAX_EVAL_TIME)
+        size_t nbReplications;  // Evaluations of replications (not counted in MAX_BB_EVAL)
+        size_t nbSteps;         // Steps done (initial design and Mads runs)
+        double wallTime;        // Seconds spent in the steps
+        NOMAD::stop_type stopType; // Stop reason of the last Mads run
+    };
+    
+private:
+    
+    std::shared_ptr<HyperParameters> _hyperParameters;
+    std::vector<NOMAD::bb_output_type> _bbot;
+    NOMAD::Display _out;
+    
+    // Parameters of the evaluator (a Mads run has its own parameters)
+    NOMAD::Parameters _p;
+    
+    HyperEvaluator _ev;
+    std::shared_ptr<ParetoArchive> _paretoArchive;
+    
+    // Evaluated with the initial design
+    std::vector<NOMAD::Point> _startingPoints;
+    
+    bool _outputFiles;
+    std::string _filePrefix;
+    bool _started;
+    bool _over;
+    size_t _nbMadsRuns;
+    
+    mutable std::mutex _statsMutex;
+    size_t _nbSteps;
+    double _wallTime;
+    NOMAD::stop_type _stopType;
+    
+    // Read the starting points and the warm start files
+    void init ( void );
+    
+    // Parameters of a Mads run (or of the evaluator) with the current structure of the hyperparameters
+    void setParameters ( NOMAD::Parameters & p , size_t maxBbEval , bool statsFile ) const;
+    
+    // Evaluate the starting points and the initial design. The best feasible point becomes X0.
+    void runInitialDesign ( void );
+    
+    // Run Mads from X0 for at most maxBbEval evaluations. Return true if the budget of the run is used.
+    bool runMads ( size_t maxBbEval );
+    
+    // Index of the first objective in the outputs
+    static int getObjIndex ( const std::vector<NOMAD::bb_output_type> & bbot );
+    
+    // Index of the best feasible evaluation (smallest first objective), -1 if none
+    static int findBest ( const std::vector<NOMAD::bb_output_type> & bbot , const std::vector<NOMAD::Point> & outputs );
+    
+public:
+    
+    // The worker pool and the cache of evaluations can be shared by campaigns (new ones if null)
+    Campaign ( std::shared_ptr<HyperParameters> hyperParameters , const NOMAD::Display & out , std::shared_ptr<WorkerPool> workerPool = nullptr , std::shared_ptr<EvaluationCache> cache = nullptr );
+    
+    // Hyperparameters file with the default blackbox scripts (see HyperParameters)
+    Campaign ( const std::string & hyperParamFileName , const std::string & pytorchBB , const std::string & pytorchSGTE , const NOMAD::Display & out , std::shared_ptr<WorkerPool> workerPool = nullptr , std::shared_ptr<EvaluationCache> cache = nullptr );
+    
+    // Evaluate the points in process instead of launching the blackbox (see HyperEvaluator::Callback). Set before the first step.
+    void setCallback ( Callback callback );
+    
+    // Release the callback (the objects it refers to are destroyed): the campaign is over and the evaluator keeps a
+    // callback that fails, the blackbox is not launched. Not called during a step.
+    void releaseCallback ( void );
+    
+    // Write the output files with a prefix ("" for history.txt, stats.txt, ...). Set before the first step.
+    void setOutputFiles ( const std::string & filePrefix );
+    
+    // Run a step: the initial design (first step, if any) or a Mads run of at most maxBbEval evaluations (0: the remaining
+    // budget of MAX_BB_EVAL). Return false when the campaign is over (budget used or Mads stopped before the end of its budget).
+    bool step ( size_t maxBbEval = 0 );
+    
+    // Run the steps until the campaign is over. Return the stop reason of the last Mads run.
+    NOMAD::stop_type run ( void );
+    
+    bool isOver ( void ) const { return _over; }
+    
+    const HyperParameters & getHyperParameters ( void ) const { return *_hyperParameters; }
+    
+    // Best feasible evaluation (smallest first objective). Return false if there is none.
+    bool getIncumbent ( Evaluation & incumbent ) const;
+    
+    // Successful evaluations in their order
+    std::vector<Evaluation> getHistory ( void ) const { return _ev.getEvaluations(); }
+    
+    Stats getStats ( void ) const;
+    
+    // Non dominated points (two objectives only, null otherwise)
+    std::shared_ptr<const ParetoArchive> getParetoArchive ( void ) const { return _paretoArchive; }
+    
+    const CostModel & getCostModel ( void ) const { return _ev.getCostModel(); }
+};
+
+#endif
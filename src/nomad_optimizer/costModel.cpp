@@ -0,0 +1,102 @@
+//
+//  costModel.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "costModel.hpp"
+
+#include <cmath>
+
+CostModel::CostModel ( const HyperParameters & hyperParameters ) :
+_layout ( hyperParameters.getBlockLayout() ),
+_dataset ( hyperParameters.getDataset() ),
+_sumLogTimePerFlop ( 0 ),
+_nbObservations ( 0 )
+{
+    for ( auto & row : _normalMatrix )
+        row.fill( 0 );
+    _normalVector.fill( 0 );
+}
+
+std::array<double,3> CostModel::getFeatures ( const NOMAD::Point & x ) const
+{
+    Architecture architecture ( _layout , _dataset , x );
+    return { 1.0 , std::log( std::max( architecture.getFlops() , 1.0 ) ) , std::log( std::max( architecture.getBatchSize() , 1 ) ) };
+}
+
+void CostModel::observe ( const NOMAD::Point & x , double seconds )
+{
+    if ( seconds <= 0 )
+        return;
+    
+    std::array<double,3> phi = getFeatures( x );
+    double y = std::log( seconds );
+    
+    std::lock_guard<std::mutex> lock ( _mutex );
+    for ( size_t i = 0 ; i < 3 ; i++ )
+    {
+        for ( size_t j = 0 ; j < 3 ; j++ )
+            _normalMatrix[i][j] += phi[i] * phi[j];
+        _normalVector[i] += phi[i] * y;
+    }
+    _sumLogTimePerFlop += y - phi[1];
+    _nbObservations++;
+}
+
+double CostModel::predict ( const NOMAD::Point & x ) const
+{
+    std::array<double,3> phi = getFeatures( x );
+    
+    std::array<std::array<double,4>,3> system;
+    {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        
+        if ( _nbObservations == 0 )
+            return std::exp( phi[1] );
+        
+        // Ridge toward the prior coefficients (mean time per flop, b=1, c=0)
+        const std::array<double,3> prior = { _sumLogTimePerFlop / _nbObservations , 1.0 , 0.0 };
+        const std::array<double,3> lambda = { 1e-6 , 1.0 , 1.0 };
+        for ( size_t i = 0 ; i < 3 ; i++ )
+        {
+            for ( size_t j = 0 ; j < 3 ; j++ )
+                system[i][j] = _normalMatrix[i][j] + ( ( i == j ) ? lambda[i] : 0.0 );
+            system[i][3] = _normalVector[i] + lambda[i] * prior[i];
+        }
+    }
+    
+    // Gaussian elimination with partial pivoting (the matrix is positive definite)
+    for ( size_t k = 0 ; k < 3 ; k++ )
+    {
+        size_t pivot = k;
+        for ( size_t i = k + 1 ; i < 3 ; i++ )
+            if ( std::fabs( system[i][k] ) > std::fabs( system[pivot][k] ) )
+                pivot = i;
+        std::swap( system[k] , system[pivot] );
+        
+        for ( size_t i = k + 1 ; i < 3 ; i++ )
+        {
+            double factor = system[i][k] / system[k][k];
+            for ( size_t j = k ; j < 4 ; j++ )
+                system[i][j] -= factor * system[k][j];
+        }
+    }
+    std::array<double,3> theta;
+    for ( int i = 2 ; i >= 0 ; i-- )
+    {
+        double v = system[i][3];
+        for ( size_t j = i + 1 ; j < 3 ; j++ )
+            v -= system[i][j] * theta[j];
+        theta[i] = v / system[i][i];
+    }
+    
+    return std::exp( theta[0] * phi[0] + theta[1] * phi[1] + theta[2] * phi[2] );
+}
+
+size_t CostModel::getNbObservations ( void ) const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    return _nbObservations;
+}
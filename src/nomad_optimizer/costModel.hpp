@@ -0,0 +1,72 @@
+//
+//  costModel.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __COSTMODEL__
+#define __COSTMODEL__
+
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+#include "architecture.hpp"
+
+#include <array>
+#include <mutex>
+
+// Prediction of the wall time of an evaluation from the decoded architecture:
+//     log(time) = a + b log(flops) + c log(batch size)
+// The coefficients are fitted on the observed wall times by a ridge regression toward a time
+// proportional to the flops (b=1, c=0). Before the first observation, the prediction is the flops.
+// Observations come from the workers.
+class CostModel
+{
+private:
+    
+    std::vector<HyperParameters::BlockLayout> _layout;
+    std::string _dataset;
+    
+    mutable std::mutex _mutex;
+    
+    // Normal equations and mean of log(time/flops) of the observations
+    std::array<std::array<double,3>,3> _normalMatrix;
+    std::array<double,3> _normalVector;
+    double _sumLogTimePerFlop;
+    size_t _nbObservations;
+    
+    std::array<double,3> getFeatures ( const NOMAD::Point & x ) const;
+    
+public:
+    
+    explicit CostModel ( const HyperParameters & hyperParameters );
+    
+    // Predicted time in seconds (relative cost before the first observation)
+    double predict ( const NOMAD::Point & x ) const;
+    
+    void observe ( const NOMAD::Point & x , double seconds );
+    
+    size_t getNbObservations ( void ) const;
+    
+};
+
+#endif
@@ -0,0 +1,64 @@
+//
+//  defaultSchema.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#ifndef __DEFAULTSCHEMA__
+#define __DEFAULTSCHEMA__
+
+#include <string>
+
+// Default search space for the Pytorch blackbox. It is compiled at startup when no SEARCH_SPACE_SCHEMA is given.
+// A custom schema uses the same syntax (display this one with hypernomad.exe -s):
+//
+//   DATASETS    name1 name2 ...                                        registered dataset names
+//   BLOCK       "name" NEIGHBOR_TYPE ASSOCIATED_TYPE                    start a new block
+//   HEAD        SEARCH_NAME "full name" TYPE value lb ub                head of the current block
+//   ASSOCIATED  SEARCH_NAME "full name" TYPE value lb ub REPORT_POLICY  one associated hyperparameter of the group
+//   X0          ( ... )                                                default starting point (optional)
+//
+// NEIGHBOR_TYPE:   NONE, PLUS_ONE_MINUS_ONE_RIGHT, PLUS_ONE_MINUS_ONE_LEFT, LOOP_PLUS_ONE_RIGHT,
+//                  LOOP_PLUS_ONE_LEFT, LOOP_MINUS_ONE_RIGHT, LOOP_MINUS_ONE_LEFT
+// ASSOCIATED_TYPE: ZERO_TIME, ONE_TIME, MULTIPLE_TIMES
+// TYPE:            CATEGORICAL, INTEGER, CONTINUOUS, BINARY
+// REPORT_POLICY:   NO_REPORT, COPY_VALUE, COPY_INITIAL_VALUE
+const std::string defaultSchema = R"(
+# Default search space of HyperNOMAD (Pytorch blackbox)
+
+DATASETS    MINIMNIST MNIST Fashion-MNIST EMNIST KMNIST CIFAR10 CIFAR100 STL10 SVHN
+
+BLOCK       "Convolutionnal layers"  PLUS_ONE_MINUS_ONE_RIGHT  MULTIPLE_TIMES
+HEAD        NUM_CON_LAYERS     "Number of convolutionnal layers"   CATEGORICAL  1    0  100
+ASSOCIATED  NUM_OUTPUT_LAYERS  "Number of output channels"         INTEGER      6    1  1000  COPY_VALUE
+ASSOCIATED  KERNELS            "Kernel size"                       INTEGER      5    1  20    COPY_VALUE
+ASSOCIATED  STRIDES            "Stride"                            INTEGER      1    1  3     COPY_VALUE
+ASSOCIATED  PADDINGS           "Padding"                           INTEGER      0    0  2     COPY_VALUE
+ASSOCIATED  POOLING_SIZE       "Pooling"                           INTEGER      2    1  5     COPY_VALUE
+
+BLOCK       "Full layers"  PLUS_ONE_MINUS_ONE_LEFT  MULTIPLE_TIMES
+HEAD        NUM_FC_LAYERS      "Number of modifyable full layers"  CATEGORICAL  2    0  500
+ASSOCIATED  SIZE_FC_LAYER      "Size of a full layer"              INTEGER      128  1  1000  COPY_VALUE
+
+BLOCK       "Batch size"  NONE  ZERO_TIME
+HEAD        BATCH_SIZE         "Batch size"                        INTEGER      128  1  400
+
+BLOCK       "Optimizer"  LOOP_PLUS_ONE_RIGHT  ONE_TIME
+HEAD        OPTIMIZER_CHOICE   "Choice of optimizer"               CATEGORICAL  3    1  4
+ASSOCIATED  OPT_PARAM_1        "Learning rate"                     CONTINUOUS   0.1     0  1  COPY_INITIAL_VALUE
+ASSOCIATED  OPT_PARAM_2        "Momentum"                          CONTINUOUS   0.9     0  1  COPY_INITIAL_VALUE
+ASSOCIATED  OPT_PARAM_3        "Weight decay"                      CONTINUOUS   0.0005  0  1  COPY_INITIAL_VALUE
+ASSOCIATED  OPT_PARAM_4        "Dampening"                         CONTINUOUS   0       0  1  COPY_INITIAL_VALUE
+
+BLOCK       "Dropout rate"  NONE  ZERO_TIME
+HEAD        DROPOUT_RATE       "Dropout rate"                      CONTINUOUS   0.2  0  0.95
+
+BLOCK       "Activation function"  NONE  ZERO_TIME
+HEAD        ACTIVATION_FUNCTION "Activation function"              INTEGER      1    1  3
+
+# Default X0 compatible with the default structure (default values in structure are changed)
+X0 ( 2    6 5 1 0 1    16 5 1 0 1    2  128 84    128    3  0.1 0.9 0.0005 0    0.2    1 )
+)";
+
+#endif
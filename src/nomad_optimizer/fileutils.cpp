@@ -1,6 +1,14 @@
 
 #include "fileutils.hpp"
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef _MSC_VER
+extern char **environ;
+#endif
+
 
 
 
@@ -56,4 +64,37 @@ bool checkAccess(const std::string &filename)
 }
 
 
+// Variables of the current process with the given ones added or replaced
+std::vector<std::string> mergeEnvironment(const Environment &environment)
+{
+    std::vector<std::string> variables;
+#ifndef _MSC_VER
+    for ( char **v = environ ; *v != nullptr ; v++ )
+    {
+        const char *sep = strchr( *v , '=' );
+        std::string name = ( sep != nullptr ) ? std::string( *v , sep - *v ) : std::string( *v );
+        bool replaced = false;
+        for ( const auto &variable : environment )
+            replaced = replaced || ( variable.first == name );
+        if ( ! replaced )
+            variables.push_back( *v );
+    }
+#endif
+    for ( const auto &variable : environment )
+        variables.push_back( variable.first + "=" + variable.second );
+    return variables;
+}
+
 
+// Shortest decimal representation of a double that is read back exactly
+std::string toRoundTripString(double value)
+{
+    char buffer[32];
+    for ( int precision = 15 ; precision <= 17 ; precision++ )
+    {
+        snprintf( buffer , sizeof(buffer) , "%.*g" , precision , value );
+        if ( strtod( buffer , nullptr ) == value )
+            break;
+    }
+    return std::string( buffer );
+}
@@ -15,14 +15,20 @@
 #include <limits>
 #include <limits.h>
 #include <cstdlib>
+#include <utility>
+#include <vector>
 
 
 // use of 'access' or '_access', and getpid() or _getpid():
 #ifdef _MSC_VER
 #include <io.h>
 #include <direct.h>
+#include <process.h>
 #define PATH_MAX 260
 #define getcwd(x,y) _getcwd(x,y)
+#define getpid _getpid
+#define popen _popen
+#define pclose _pclose
 #define isdigit(x) iswdigit(x)
 #else
 #include <unistd.h>
@@ -50,4 +56,13 @@ std::string extractDir(const std::string &filename);
 // Check if a file exists and is readable
 bool checkAccess(const std::string &filename);
 
+// Environment variables given to a launched command (name, value)
+typedef std::vector<std::pair<std::string, std::string>> Environment;
+
+// Variables of the current process ("NAME=value") with the given ones added or replaced: environment of a child process
+std::vector<std::string> mergeEnvironment(const Environment &environment);
+
+// Shortest decimal representation of a double that is read back exactly (15 to 17 significant digits)
+std::string toRoundTripString(double value);
+
 #endif
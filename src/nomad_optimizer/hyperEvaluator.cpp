@@ -0,0 +1,1170 @@
+//
+//  hyperEvaluator.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "hyperEvaluator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <map>
+#include <thread>
+
+#ifndef _MSC_VER
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#endif
+
+// One-sided 95% quantile of the Student t distribution (df rounded down, normal beyond 30)
+static double studentQuantile95 ( double df )
+{
+    static const double quantiles[] = { 6.314 , 2.920 , 2.353 , 2.132 , 2.015 , 1.943 , 1.895 , 1.860 , 1.833 , 1.812 ,
+                                        1.796 , 1.782 , 1.771 , 1.761 , 1.753 , 1.746 , 1.740 , 1.734 , 1.729 , 1.725 ,
+                                        1.721 , 1.717 , 1.714 , 1.711 , 1.708 , 1.706 , 1.703 , 1.701 , 1.699 , 1.697 };
+    if ( df < 1 )
+        return quantiles[0];
+    size_t i = static_cast<size_t>( df );
+    return ( i <= 30 ) ? quantiles[i-1] : 1.645;
+}
+
+void ReplicationStatistics::add ( double f )
+{
+    n++;
+    double delta = f - mean;
+    mean += delta / n;
+    m2 += delta * ( f - mean );
+}
+
+bool ReplicationStatistics::isSignificantlyLower ( const ReplicationStatistics & a , const ReplicationStatistics & b )
+{
+    if ( a.mean >= b.mean )
+        return false;
+    
+    if ( a.n < 2 || b.n < 2 )
+        return true;
+    
+    double va = a.variance() / a.n;
+    double vb = b.variance() / b.n;
+    
+    // No noise
+    if ( va + vb <= 0 )
+        return true;
+    
+    // Welch-Satterthwaite degrees of freedom
+    double df = ( va + vb ) * ( va + vb ) / ( va * va / ( a.n - 1 ) + vb * vb / ( b.n - 1 ) );
+    
+    return ( b.mean - a.mean ) / std::sqrt( va + vb ) > studentQuantile95( df );
+}
+
+std::string EvaluationCache::key ( const std::string & command , const NOMAD::Point & x )
+{
+    std::ostringstream oss;
+    // Exact and cheaper than a decimal conversion
+    oss << command << " :" << std::hexfloat;
+    for ( int i = 0 ; i < x.size() ; i++ )
+    {
+        if ( x[i].is_defined() )
+            oss << " " << x[i].value();
+        else
+            oss << " -";
+    }
+    return oss.str();
+}
+
+bool EvaluationCache::find ( const std::string & key , NOMAD::Point & outputs ) const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+
+    auto it = _outputs.find( key );
+    if ( it == _outputs.end() )
+        return false;
+
+    outputs = it->second;
+    _nbHits++;
+    return true;
+}
+
+void EvaluationCache::insert ( const std::string & key , const NOMAD::Point & outputs )
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    _outputs[key] = outputs;
+}
+
+bool EvaluationCache::findStatistics ( const std::string & key , ReplicationStatistics & statistics ) const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    
+    auto it = _statistics.find( key );
+    if ( it == _statistics.end() )
+        return false;
+    
+    statistics = it->second;
+    return true;
+}
+
+void EvaluationCache::insertStatistics ( const std::string & key , const ReplicationStatistics & statistics )
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    _statistics[key] = statistics;
+}
+
+size_t EvaluationCache::size ( void ) const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    return _outputs.size();
+}
+
+size_t EvaluationCache::getNbHits ( void ) const
+{
+    std::lock_guard<std::mutex> lock ( _mutex );
+    return _nbHits;
+}
+
+
+void WorkerPool::run ( const std::vector<std::function<void()>> & jobs ) const
+{
+    if ( jobs.empty() )
+        return;
+
+    std::lock_guard<std::mutex> lock ( _runMutex );
+
+    // A single job does not need a thread
+    if ( jobs.size() == 1 || _nbWorkers == 1 )
+    {
+        for ( const auto & job : jobs )
+            job();
+        return;
+    }
+
+    // Each worker takes the next job available
+    std::atomic<size_t> nextJob ( 0 );
+    auto worker = [&jobs,&nextJob]()
+    {
+        size_t i;
+        while ( ( i = nextJob++ ) < jobs.size() )
+            jobs[i]();
+    };
+
+    std::vector<std::thread> threads;
+    size_t nbThreads = std::min( _nbWorkers , jobs.size() );
+    for ( size_t i = 0 ; i < nbThreads ; i++ )
+        threads.push_back( std::thread( worker ) );
+
+    for ( auto & t : threads )
+        t.join();
+}
+
+void WorkerPool::runLongestFirst ( const std::vector<std::function<void()>> & jobs , const std::vector<double> & costs ) const
+{
+    // The order does not matter when all the jobs start at once
+    if ( jobs.size() <= _nbWorkers || costs.size() != jobs.size() )
+    {
+        run( jobs );
+        return;
+    }
+    
+    std::vector<size_t> order ( jobs.size() );
+    for ( size_t i = 0 ; i < order.size() ; i++ )
+        order[i] = i;
+    std::stable_sort( order.begin() , order.end() , [&costs]( size_t a , size_t b ) { return costs[a] > costs[b]; } );
+    
+    std::vector<std::function<void()>> sortedJobs;
+    for ( size_t i : order )
+        sortedJobs.push_back( jobs[i] );
+    run( sortedJobs );
+}
+
+bool WorkerPool::runCommand ( const std::string & command , std::string & output )
+{
+    bool timedOut;
+    return runCommand( command , Environment() , output , 0 , timedOut );
+}
+
+#ifdef _MSC_VER
+
+// No time budget on Windows. The child process gets the environment of the process when it is created: the variables are
+// set for the time of the launch (one launch at a time).
+bool WorkerPool::runCommand ( const std::string & command , const Environment & environment , std::string & output , double timeout , bool & timedOut )
+{
+    output.clear();
+    timedOut = false;
+
+    static std::mutex environmentMutex;
+    FILE * pipe = nullptr;
+    {
+        std::lock_guard<std::mutex> lock ( environmentMutex );
+        std::vector<std::pair<std::string,std::string>> previous;
+        for ( const auto & variable : environment )
+        {
+            const char * value = std::getenv( variable.first.c_str() );
+            previous.emplace_back( variable.first , ( value != nullptr ) ? value : "" );
+            _putenv_s( variable.first.c_str() , variable.second.c_str() );
+        }
+        pipe = popen( command.c_str() , "r" );
+        for ( const auto & variable : previous )
+            _putenv_s( variable.first.c_str() , variable.second.c_str() );
+    }
+    if ( pipe == nullptr )
+        return false;
+
+    char buffer[256];
+    while ( fgets( buffer , sizeof(buffer) , pipe ) != nullptr )
+        output += buffer;
+
+    return ( pclose( pipe ) != -1 );
+}
+
+#else
+
+bool WorkerPool::runCommand ( const std::string & command , const Environment & environment , std::string & output , double timeout , bool & timedOut )
+{
+    output.clear();
+    timedOut = false;
+
+    // The environment is built before the fork: only exec is called by the child
+    std::vector<std::string> variables = mergeEnvironment( environment );
+    std::vector<char *> envp;
+    for ( auto & variable : variables )
+        envp.push_back( &variable[0] );
+    envp.push_back( nullptr );
+
+    // The pipe is closed on exec: the commands launched at the same time by the other workers (and the workers of shared
+    // memory) must not keep its write end, or the end of the output is not seen before they exit
+    int fds[2];
+#ifdef __linux__
+    if ( pipe2( fds , O_CLOEXEC ) != 0 )
+        return false;
+#else
+    if ( pipe( fds ) != 0 )
+        return false;
+    fcntl( fds[0] , F_SETFD , FD_CLOEXEC );
+    fcntl( fds[1] , F_SETFD , FD_CLOEXEC );
+#endif
+
+    pid_t pid = fork();
+    if ( pid < 0 )
+    {
+        close( fds[0] );
+        close( fds[1] );
+        return false;
+    }
+
+    // The shell and the processes it starts are in a process group of their own: they are all killed after the time budget
+    if ( pid == 0 )
+    {
+        setpgid( 0 , 0 );
+        dup2( fds[1] , STDOUT_FILENO );
+        close( fds[0] );
+        close( fds[1] );
+        execle( "/bin/sh" , "sh" , "-c" , command.c_str() , static_cast<char *>( nullptr ) , envp.data() );
+        _exit( 127 );
+    }
+    setpgid( pid , pid );
+    close( fds[1] );
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>( timeout );
+    char buffer[256];
+    while ( true )
+    {
+        int waitMs = -1;
+        if ( timeout > 0 )
+        {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>( deadline - std::chrono::steady_clock::now() ).count();
+            if ( remaining <= 0 )
+            {
+                kill( -pid , SIGKILL );
+                timedOut = true;
+                break;
+            }
+            waitMs = static_cast<int>( std::min<long long>( remaining , 1000 ) );
+        }
+
+        struct pollfd p = { fds[0] , POLLIN , 0 };
+        int r = poll( &p , 1 , waitMs );
+        if ( r < 0 && errno != EINTR )
+            break;
+        if ( r <= 0 )
+            continue;
+
+        ssize_t n = read( fds[0] , buffer , sizeof(buffer) );
+        if ( n < 0 && errno == EINTR )
+            continue;
+        if ( n <= 0 )
+            break;
+        output.append( buffer , static_cast<size_t>( n ) );
+    }
+    close( fds[0] );
+
+    int status;
+    while ( waitpid( pid , &status , 0 ) < 0 && errno == EINTR ) {}
+    return ! timedOut;
+}
+
+#endif
+
+
+HyperEvaluator::HyperEvaluator ( const NOMAD::Parameters & p , const HyperParameters & hyperParameters , std::shared_ptr<WorkerPool> workerPool , std::shared_ptr<EvaluationCache> cache ) :
+NOMAD::Evaluator ( p ),
+_workerPool ( std::move(workerPool) ),
+_cache ( std::move(cache) ),
+_bbCommand ( toShellCommand( hyperParameters.getBB() ) ),
+_sgteCommand ( toShellCommand( hyperParameters.getSGTE() ) ),
+_bbot ( hyperParameters.getBbOutputType() ),
+_nbOutputs ( _bbot.size() ),
+_nbBlackboxOutputs ( _bbot.size() - hyperParameters.getSizeOutputs().size() ),
+_objIndex ( 0 ),
+_secondObjIndex ( 0 ),
+_replications ( hyperParameters.getReplications() ),
+_nbReplications ( 0 ),
+_coSchedulingNetworks ( hyperParameters.getCoSchedulingNetworks() ),
+_coSchedulingMaxParameters ( hyperParameters.getCoSchedulingMaxParameters() ),
+_hasIncumbent ( false ),
+_layout ( hyperParameters.getBlockLayout() ),
+_dataset ( hyperParameters.getDataset() ),
+_sizeOutputs ( hyperParameters.getSizeOutputs() ),
+_extraOutputs ( hyperParameters.getExtraOutputs() ),
+_nbRejected ( 0 ),
+_maxEvalTime ( hyperParameters.getMaxEvalTime() ),
+_evalTimeMedianFactor ( hyperParameters.getEvalTimeMedianFactor() ),
+_nbTimedOut ( 0 ),
+_nbRecorded ( 0 ),
+_nbEval ( 0 )
+{
+    std::vector<size_t> objIndices;
+    for ( size_t i = 0 ; i < _bbot.size() ; i++ )
+    {
+        if ( _bbot[i] == NOMAD::OBJ )
+            objIndices.push_back( i );
+    }
+    if ( ! objIndices.empty() )
+        _objIndex = objIndices[0];
+    _secondObjIndex = ( objIndices.size() > 1 ) ? objIndices[1] : _objIndex;
+    
+    std::string extraOutputs;
+    for ( size_t i = 0 ; i < _extraOutputs.size() ; i++ )
+        extraOutputs += ( ( i == 0 ) ? "" : "," ) + _extraOutputs[i].name;
+    if ( ! extraOutputs.empty() )
+        _environment.emplace_back( "HYPERNOMAD_OUTPUTS" , extraOutputs );
+    if ( hyperParameters.getMaxEpochs() > 0 )
+        _environment.emplace_back( "HYPERNOMAD_MAX_EPOCHS" , std::to_string( hyperParameters.getMaxEpochs() ) );
+    for ( const auto & variable : _environment )
+        _environmentKey += variable.first + "=" + variable.second + " ";
+    
+    if ( SyntheticBlackbox::isSynthetic( _bbCommand ) )
+        _synthetic = std::make_shared<SyntheticBlackbox>( _bbCommand , hyperParameters );
+    
+    _costModel = std::make_shared<CostModel>( hyperParameters );
+    
+    if ( ! _workerPool )
+        _workerPool = std::make_shared<WorkerPool>( 1 );
+    if ( ! _cache )
+        _cache = std::make_shared<EvaluationCache>();
+    
+    if ( hyperParameters.isSharedMemoryTransfer() && ! _synthetic )
+    {
+        // Slots large enough for the largest structure (a larger point is given in a file)
+        size_t maxDimension = hyperParameters.getDimension();
+        size_t layoutDimension = 0;
+        for ( const auto & block : _layout )
+        {
+            size_t nbGroups = ( block.multipleGroups && block.headUpperBound.is_defined() ) ? static_cast<size_t>( block.headUpperBound.round() ) : 1;
+            layoutDimension += 1 + nbGroups * block.groupSize;
+        }
+        maxDimension = std::max( maxDimension , layoutDimension );
+        
+        // One slot per worker of the pool
+        _sharedMemoryRing = std::make_shared<SharedMemoryRing>( toShellCommand( hyperParameters.getBBWorker() ) , _environment , _workerPool->getNbWorkers() , maxDimension , _nbBlackboxOutputs );
+    }
+}
+
+std::string HyperEvaluator::toShellCommand ( const std::string & bbExe )
+{
+    std::string command;
+    std::istringstream iss ( bbExe );
+    std::string word;
+    while ( iss >> word )
+    {
+        if ( word[0] == '$' )
+            word.erase( 0 , 1 );
+        if ( ! command.empty() )
+            command += " ";
+        command += word;
+    }
+    return command;
+}
+
+bool HyperEvaluator::isConstraint ( NOMAD::bb_output_type bbot )
+{
+    return ( bbot == NOMAD::PB || bbot == NOMAD::EB || bbot == NOMAD::PEB_P || bbot == NOMAD::PEB_E || bbot == NOMAD::FILTER );
+}
+
+bool HyperEvaluator::isFeasible ( const NOMAD::Point & outputs ) const
+{
+    if ( outputs.size() != static_cast<int>( _nbOutputs ) )
+        return false;
+    
+    for ( size_t j = 0 ; j < _nbOutputs ; j++ )
+    {
+        if ( isConstraint( _bbot[j] ) && ( ! outputs[static_cast<int>(j)].is_defined() || outputs[static_cast<int>(j)] > 0 ) )
+            return false;
+    }
+    return true;
+}
+
+void HyperEvaluator::writeValues ( std::ostream & out , const NOMAD::Point & x )
+{
+    for ( int i = 0 ; i < x.size() ; i++ )
+        out << ( ( x[i].is_defined() ) ? toRoundTripString( x[i].value() ) : "-" ) << " ";
+}
+
+void HyperEvaluator::setHistoryFile ( const std::string & fileName )
+{
+    _history.open( fileName.c_str() );
+    if ( _history.fail() )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "Cannot open the history file " + fileName );
+}
+
+void HyperEvaluator::setCensoredFile ( const std::string & fileName )
+{
+    _censored.open( fileName.c_str() );
+    if ( _censored.fail() )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "Cannot open the file of censored evaluations " + fileName );
+}
+
+void HyperEvaluator::setTraceFile ( const std::string & fileName )
+{
+    _traces.open( fileName.c_str() );
+    if ( _traces.fail() )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "Cannot open the trace file " + fileName );
+    _traces << "evaluation,epoch,train_loss,train_accuracy,val_loss,val_accuracy,learning_rate,time" << std::endl;
+}
+
+void HyperEvaluator::setCallback ( Callback callback )
+{
+    _callback = std::move( callback );
+    
+    // The persistent workers of the default blackbox are not used
+    if ( _callback )
+        _sharedMemoryRing.reset();
+}
+
+std::vector<HyperEvaluator::Evaluation> HyperEvaluator::getEvaluations ( void ) const
+{
+    std::lock_guard<std::mutex> lock ( _evaluationsMutex );
+    return _evaluations;
+}
+
+size_t HyperEvaluator::getNbEvaluations ( void ) const
+{
+    std::lock_guard<std::mutex> lock ( _evaluationsMutex );
+    return _evaluations.size();
+}
+
+void HyperEvaluator::setParetoArchive ( std::shared_ptr<ParetoArchive> paretoArchive , const std::string & fileName )
+{
+    if ( _secondObjIndex == _objIndex )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "A Pareto archive requires two objectives" );
+    
+    _paretoArchive = std::move( paretoArchive );
+    _paretoFileName = fileName;
+}
+
+void HyperEvaluator::updateParetoArchive ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , const std::vector<NOMAD::Point> & outputs , const std::vector<char> & success ) const
+{
+    const int obj1 = static_cast<int>( _objIndex );
+    const int obj2 = static_cast<int>( _secondObjIndex );
+    
+    bool changed = false;
+    for ( size_t i = 0 ; i < points.size() ; i++ )
+    {
+        if ( ! success[i] || commands[i] != &_bbCommand || ! isFeasible( outputs[i] ) )
+            continue;
+        
+        if ( ! outputs[i][obj1].is_defined() || ! outputs[i][obj2].is_defined() )
+            continue;
+        
+        if ( _paretoArchive->insert( *points[i] , outputs[i] , outputs[i][obj1].value() , outputs[i][obj2].value() ) )
+            changed = true;
+    }
+    
+    if ( changed && ! _paretoFileName.empty() && ! _paretoArchive->write( _paretoFileName ) )
+        std::cerr << "Cannot write the Pareto archive in " << _paretoFileName << std::endl;
+}
+
+bool HyperEvaluator::precheck ( const NOMAD::Point & x , std::vector<NOMAD::Double> & sizeOutputs ) const
+{
+    Architecture architecture ( _layout , _dataset , x );
+    
+    std::string error;
+    if ( ! architecture.checkShapes( error ) )
+        return false;
+    
+    bool launch = true;
+    sizeOutputs.clear();
+    for ( const auto & c : _sizeOutputs )
+    {
+        double value = ( c.type == HyperParameters::SizeOutputType::PARAMETERS ) ? architecture.getNbParameters() : architecture.getTrainingMemory() / ( 1024.0 * 1024.0 );
+        sizeOutputs.push_back( ( c.bbot == NOMAD::OBJ ) ? value : value / c.bound - 1.0 );
+        
+        if ( c.bbot == NOMAD::EB && sizeOutputs.back() > 0 )
+            launch = false;
+    }
+    return launch;
+}
+
+NOMAD::Point HyperEvaluator::completeOutputs ( const NOMAD::Point & blackboxOutputs , const std::vector<NOMAD::Double> & sizeOutputs ) const
+{
+    NOMAD::Point outputs ( static_cast<int>( _nbOutputs ) );
+    for ( size_t j = 0 ; j < _nbBlackboxOutputs ; j++ )
+        outputs[static_cast<int>(j)] = blackboxOutputs[static_cast<int>(j)];
+    
+    // The extra outputs are the last outputs of the blackbox
+    const size_t firstExtra = _nbBlackboxOutputs - _extraOutputs.size();
+    for ( size_t j = 0 ; j < _extraOutputs.size() ; j++ )
+    {
+        NOMAD::Double & v = outputs[static_cast<int>( firstExtra + j )];
+        if ( isConstraint( _extraOutputs[j].bbot ) && v.is_defined() )
+            v = v / _extraOutputs[j].bound - 1.0;
+    }
+    
+    for ( size_t j = 0 ; j < sizeOutputs.size() ; j++ )
+        outputs[static_cast<int>( _nbBlackboxOutputs + j )] = sizeOutputs[j];
+    return outputs;
+}
+
+const std::string & HyperEvaluator::getCommand ( const NOMAD::Eval_Point & x ) const
+{
+    return ( x.get_eval_type() == NOMAD::SGTE ) ? _sgteCommand : _bbCommand ;
+}
+
+// Content of the trace written by the blackbox. The file is removed.
+static void readTrace ( const std::string & fileName , std::string * trace )
+{
+    if ( fileName.empty() )
+        return;
+    if ( trace )
+    {
+        std::ifstream in ( fileName.c_str() );
+        std::ostringstream oss;
+        oss << in.rdbuf();
+        *trace = oss.str();
+    }
+    std::remove( fileName.c_str() );
+}
+
+// Name of an input file of the blackbox (one per launch, workers run simultaneously)
+static std::string newInputFileName ( void )
+{
+    static std::atomic<size_t> nbInputFiles ( 0 );
+    std::ostringstream inputFileName;
+    inputFileName << ".hypernomad." << getpid() << "." << nbInputFiles++ << ".input";
+    return inputFileName.str();
+}
+
+double HyperEvaluator::getTimeBudget ( void ) const
+{
+    if ( _maxEvalTime <= 0 )
+        return 0;
+    
+    std::lock_guard<std::mutex> lock ( _evaluationTimesMutex );
+    if ( _evalTimeMedianFactor <= 0 || _evaluationTimes.size() < 5 )
+        return _maxEvalTime;
+    
+    std::vector<double> times ( _evaluationTimes );
+    auto median = times.begin() + times.size() / 2;
+    std::nth_element( times.begin() , median , times.end() );
+    return std::min( _maxEvalTime , _evalTimeMedianFactor * *median );
+}
+
+void HyperEvaluator::observe ( const NOMAD::Point & x , double seconds , bool censored ) const
+{
+    // A censored time is a lower bound: the cost model still learns that the point is long
+    _costModel->observe( x , seconds );
+    if ( censored )
+        return;
+    
+    std::lock_guard<std::mutex> lock ( _evaluationTimesMutex );
+    _evaluationTimes.push_back( seconds );
+}
+
+bool HyperEvaluator::launch ( const std::string & command , const NOMAD::Point & x , NOMAD::Point & outputs , int seed , LaunchRecord * record ) const
+{
+    // Evaluation by the host process
+    if ( _callback )
+    {
+        outputs.reset( static_cast<int>(_nbBlackboxOutputs) );
+        return _callback( x , outputs , seed ) && outputs.size() == static_cast<int>(_nbBlackboxOutputs) && outputs.is_complete();
+    }
+    
+    // Synthetic blackbox: objective computed in process, other outputs are 0 (feasible)
+    if ( _synthetic )
+    {
+        outputs.reset( static_cast<int>(_nbBlackboxOutputs) , 0 );
+        return _synthetic->evaluate( x , outputs[static_cast<int>(_objIndex)] );
+    }
+    
+    // Time budget of the blackbox (not the surrogate)
+    const double timeout = ( &command == &_bbCommand ) ? getTimeBudget() : 0;
+    bool timedOut = false;
+    
+    // Persistent workers: no input file and no text conversion
+    if ( _sharedMemoryRing && &command == &_bbCommand && _sharedMemoryRing->fits( x , _nbBlackboxOutputs ) )
+    {
+        std::string traceFileName;
+        bool success = _sharedMemoryRing->evaluate( x , seed , _nbBlackboxOutputs , outputs , traceFileName , timeout , timedOut );
+        readTrace( traceFileName , ( success && record ) ? &record->trace : nullptr );
+        if ( timedOut && record )
+            record->censoredTime = timeout;
+        return success;
+    }
+    
+    // Input file (one per launch, workers run simultaneously)
+    const std::string inputFileName = newInputFileName();
+
+    std::ofstream fout ( inputFileName.c_str() );
+    if ( fout.fail() )
+        return false;
+    writeValues( fout , x );
+    fout << std::endl;
+    fout.close();
+
+    // The seed is passed to the blackbox in its environment
+    Environment environment = _environment;
+    if ( seed >= 0 )
+        environment.emplace_back( "HYPERNOMAD_SEED" , std::to_string( seed ) );
+
+    // The metrics of each epoch are written next to the input file
+    const std::string traceFileName = inputFileName + ".trace";
+    environment.emplace_back( "HYPERNOMAD_TRACE" , traceFileName );
+
+    std::string output;
+    bool launched = WorkerPool::runCommand( command + " " + inputFileName , environment , output , timeout , timedOut );
+
+    std::remove( inputFileName.c_str() );
+    readTrace( traceFileName , ( launched && record ) ? &record->trace : nullptr );
+    
+    if ( timedOut && record )
+        record->censoredTime = timeout;
+
+    if ( ! launched )
+        return false;
+
+    // Read the outputs as Nomad does
+    std::istringstream iss ( output );
+    std::string s;
+    outputs.reset( static_cast<int>(_nbBlackboxOutputs) );
+    for ( size_t i = 0 ; i < _nbBlackboxOutputs ; i++ )
+    {
+        if ( ! ( iss >> s ) || ! outputs[static_cast<int>(i)].atof( s ) )
+            return false;
+    }
+    return outputs.is_complete();
+}
+
+void HyperEvaluator::launchPack ( const std::vector<size_t> & pack , const std::vector<const NOMAD::Point *> & points , std::vector<NOMAD::Point> & outputs , std::vector<char> & success , int seed , std::vector<LaunchRecord> & records ) const
+{
+    auto start = std::chrono::steady_clock::now();
+    
+    const std::string inputFileName = newInputFileName();
+    std::ofstream fout ( inputFileName.c_str() );
+    if ( fout.fail() )
+        return;
+    for ( size_t k : pack )
+    {
+        writeValues( fout , *points[k] );
+        fout << std::endl;
+    }
+    fout.close();
+    
+    Environment environment = _environment;
+    if ( seed >= 0 )
+        environment.emplace_back( "HYPERNOMAD_SEED" , std::to_string( seed ) );
+    
+    const std::string traceFileName = inputFileName + ".trace";
+    environment.emplace_back( "HYPERNOMAD_TRACE" , traceFileName );
+    
+    // The networks of the pack share the time budget of the pack
+    const double timeout = getTimeBudget() * pack.size();
+    bool timedOut = false;
+    
+    std::string output , trace;
+    bool launched = WorkerPool::runCommand( _bbCommand + " " + inputFileName , environment , output , timeout , timedOut );
+    
+    std::remove( inputFileName.c_str() );
+    readTrace( traceFileName , ( launched ) ? &trace : nullptr );
+    
+    if ( timedOut )
+    {
+        for ( size_t k : pack )
+        {
+            records[k].censoredTime = timeout / pack.size();
+            observe( *points[k] , records[k].censoredTime , true );
+        }
+    }
+    
+    if ( ! launched )
+        return;
+    
+    // One line of outputs per point in the order of the input file ("Inf" for a network that failed)
+    std::istringstream iss ( output );
+    std::string line , s;
+    size_t nbSuccess = 0;
+    for ( size_t k : pack )
+    {
+        if ( ! std::getline( iss , line ) )
+            break;
+        
+        std::istringstream lineStream ( line );
+        outputs[k].reset( static_cast<int>(_nbBlackboxOutputs) );
+        bool complete = true;
+        for ( size_t j = 0 ; j < _nbBlackboxOutputs && complete ; j++ )
+            complete = ( lineStream >> s ) && outputs[k][static_cast<int>(j)].atof( s );
+        
+        success[k] = ( complete && outputs[k].is_complete() ) ? 1 : 0;
+        if ( success[k] )
+            nbSuccess++;
+    }
+    
+    // The lines of the trace start with the position of the network in the pack
+    std::istringstream traceStream ( trace );
+    while ( std::getline( traceStream , line ) )
+    {
+        size_t comma = line.find( ',' );
+        int position;
+        if ( comma == std::string::npos || ! NOMAD::atoi( line.substr( 0 , comma ) , position ) || position < 0 || static_cast<size_t>( position ) >= pack.size() )
+            continue;
+        records[pack[position]].trace += line.substr( comma + 1 ) + "\n";
+    }
+    
+    // The networks are trained together: each one is given a share of the wall time in proportion to the training time
+    // it reports (TRAINING_TIME output, for all the networks), or to its predicted time
+    int trainingTimeIndex = -1;
+    for ( size_t j = 0 ; j < _extraOutputs.size() ; j++ )
+    {
+        if ( _extraOutputs[j].name == "TRAINING_TIME" )
+            trainingTimeIndex = static_cast<int>( _nbBlackboxOutputs - _extraOutputs.size() + j );
+    }
+    bool reported = ( trainingTimeIndex >= 0 );
+    for ( size_t k : pack )
+    {
+        if ( success[k] && reported )
+            reported = outputs[k][trainingTimeIndex].is_defined() && outputs[k][trainingTimeIndex] > 0;
+    }
+    std::vector<double> weights ( outputs.size() , 0.0 );
+    double totalWeight = 0;
+    for ( size_t k : pack )
+    {
+        if ( ! success[k] )
+            continue;
+        weights[k] = ( reported ) ? outputs[k][trainingTimeIndex].value() : _costModel->predict( *points[k] );
+        totalWeight += weights[k];
+    }
+    
+    const double time = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    for ( size_t k : pack )
+    {
+        if ( success[k] )
+            observe( *points[k] , ( totalWeight > 0 ) ? time * weights[k] / totalWeight : time / nbSuccess );
+    }
+}
+
+std::vector<std::vector<size_t>> HyperEvaluator::coSchedule ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , const std::vector<size_t> & launched ) const
+{
+    std::vector<std::vector<size_t>> packs;
+    
+    const size_t nbWorkers = _workerPool->getNbWorkers();
+    const size_t packSize = std::min( _coSchedulingNetworks , ( launched.size() + nbWorkers - 1 ) / nbWorkers );
+    
+    // Small networks by batch size
+    std::map<int,std::vector<size_t>> smallNetworks;
+    for ( size_t i : launched )
+    {
+        if ( packSize > 1 && ! _callback && commands[i] == &_bbCommand )
+        {
+            Architecture architecture ( _layout , _dataset , *points[i] );
+            if ( architecture.isKnown() && architecture.getNbParameters() <= _coSchedulingMaxParameters )
+            {
+                smallNetworks[architecture.getBatchSize()].push_back( i );
+                continue;
+            }
+        }
+        packs.push_back( std::vector<size_t> ( 1 , i ) );
+    }
+    
+    for ( const auto & s : smallNetworks )
+    {
+        for ( size_t first = 0 ; first < s.second.size() ; first += packSize )
+            packs.push_back( std::vector<size_t> ( s.second.begin() + first , s.second.begin() + std::min( first + packSize , s.second.size() ) ) );
+    }
+    return packs;
+}
+
+bool HyperEvaluator::launchAndObserve ( const std::string & command , const NOMAD::Point & x , NOMAD::Point & outputs , int seed , LaunchRecord * record ) const
+{
+    LaunchRecord localRecord;
+    if ( ! record )
+        record = &localRecord;
+    
+    auto start = std::chrono::steady_clock::now();
+    bool success = launch( command , x , outputs , seed , record );
+    
+    // Only the evaluations of the blackbox (not the surrogate) are learned
+    if ( &command == &_bbCommand )
+    {
+        if ( success )
+            observe( x , std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() );
+        else if ( record->censoredTime > 0 )
+            observe( x , record->censoredTime , true );
+    }
+    
+    return success;
+}
+
+bool HyperEvaluator::eval_x ( NOMAD::Eval_Point & x , const NOMAD::Double & h_max , bool & count_eval ) const
+{
+    std::list<NOMAD::Eval_Point *> list_x ( 1 , &x );
+    std::list<bool> list_count_eval;
+
+    std::list<bool> success = eval_x ( list_x , h_max , list_count_eval );
+
+    count_eval = list_count_eval.front();
+    return success.front();
+}
+
+void HyperEvaluator::record ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , const std::vector<NOMAD::Point> & outputs , const std::vector<char> & success , const std::vector<char> & countEval , const std::vector<LaunchRecord> & records ) const
+{
+    for ( size_t i = 0 ; i < points.size() ; i++ )
+    {
+        if ( ! countEval[i] || commands[i] != &_bbCommand )
+            continue;
+        
+        ++_nbEval;
+        
+        // Stopped after its time budget: the time of the evaluation is at least the budget
+        if ( ! success[i] && records[i].censoredTime > 0 )
+        {
+            _nbTimedOut++;
+            if ( _censored.is_open() )
+            {
+                writeValues( _censored , *points[i] );
+                _censored << ">= " << records[i].censoredTime << std::endl;
+            }
+            continue;
+        }
+        
+        if ( ! success[i] )
+            continue;
+        
+        // Number of the evaluation: line in the history
+        ++_nbRecorded;
+        
+        if ( _history.is_open() )
+        {
+            writeValues( _history , *points[i] );
+            writeValues( _history , outputs[i] );
+            _history << std::endl;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock ( _evaluationsMutex );
+            _evaluations.push_back( { *points[i] , outputs[i] } );
+        }
+        
+        if ( _traces.is_open() && ! records[i].trace.empty() )
+        {
+            std::istringstream iss ( records[i].trace );
+            std::string line;
+            while ( std::getline( iss , line ) )
+            {
+                if ( ! line.empty() )
+                    _traces << _nbRecorded << "," << line << "\n";
+            }
+            _traces.flush();
+        }
+    }
+}
+
+size_t HyperEvaluator::evaluateBlock ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , std::vector<NOMAD::Point> & outputs , std::vector<char> & success , std::vector<char> & countEval ) const
+{
+    outputs.assign( points.size() , NOMAD::Point() );
+    std::vector<std::string> keys ( points.size() );
+    
+    // char instead of bool: each worker writes its own element
+    success.assign( points.size() , 0 );
+    countEval.assign( points.size() , 0 );
+    
+    std::vector<std::vector<NOMAD::Double>> sizeOutputs ( points.size() );
+    std::vector<LaunchRecord> records ( points.size() );
+    
+    // Points in cache are not launched again
+    std::vector<size_t> launched;
+    for ( size_t i = 0 ; i < points.size() ; i++ )
+    {
+        // Failed evaluation without launching the blackbox
+        if ( ! precheck( *points[i] , sizeOutputs[i] ) )
+        {
+            _nbRejected++;
+            continue;
+        }
+        
+        const std::string & command = *commands[i];
+        keys[i] = EvaluationCache::key( _environmentKey + command , *points[i] );
+        
+        if ( _cache->find( keys[i] , outputs[i] ) )
+        {
+            success[i] = 1;
+            continue;
+        }
+        launched.push_back( i );
+    }
+    
+    std::vector<std::function<void()>> jobs;
+    std::vector<double> costs;
+    for ( const std::vector<size_t> & pack : coSchedule( points , commands , launched ) )
+    {
+        const size_t i = pack.front();
+        const std::string & command = *commands[i];
+        
+        // The first evaluation of a point that can be replicated has seed 0
+        int seed = ( _replications > 1 && commands[i] == &_bbCommand ) ? 0 : -1;
+        
+        if ( pack.size() > 1 )
+        {
+            jobs.push_back( [this,pack,seed,&points,&outputs,&keys,&success,&countEval,&records]()
+            {
+                for ( size_t k : pack )
+                    countEval[k] = 1;
+                launchPack( pack , points , outputs , success , seed , records );
+                for ( size_t k : pack )
+                {
+                    if ( success[k] )
+                        _cache->insert( keys[k] , outputs[k] );
+                }
+            });
+        }
+        else
+        {
+            jobs.push_back( [this,i,seed,&command,&points,&outputs,&keys,&success,&countEval,&records]()
+            {
+                countEval[i] = 1;
+                if ( launchAndObserve( command , *points[i] , outputs[i] , seed , &records[i] ) )
+                {
+                    success[i] = 1;
+                    _cache->insert( keys[i] , outputs[i] );
+                }
+            });
+        }
+        
+        double cost = 0;
+        for ( size_t k : pack )
+            cost += _costModel->predict( *points[k] );
+        costs.push_back( cost );
+    }
+    
+    _workerPool->runLongestFirst( jobs , costs );
+    
+    for ( size_t i = 0 ; i < points.size() ; i++ )
+    {
+        if ( success[i] )
+            outputs[i] = completeOutputs( outputs[i] , sizeOutputs[i] );
+    }
+    
+    record( points , commands , outputs , success , countEval , records );
+    
+    if ( _paretoArchive )
+        updateParetoArchive( points , commands , outputs , success );
+    
+    if ( _replications < 2 )
+        return 0;
+    
+    return replicate( points , commands , keys , outputs , success );
+}
+
+size_t HyperEvaluator::replicate ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , const std::vector<std::string> & keys , std::vector<NOMAD::Point> & outputs , const std::vector<char> & success ) const
+{
+    const int obj = static_cast<int>( _objIndex );
+    
+    std::vector<ReplicationStatistics> statistics ( points.size() );
+    std::vector<char> replicated ( points.size() , 0 );
+    std::vector<std::vector<NOMAD::Point>> replicationOutputs ( points.size() );
+    std::vector<std::vector<char>> replicationSuccess ( points.size() );
+    
+    std::vector<char> candidate ( points.size() , 0 );
+    NOMAD::Double bestF;
+    for ( size_t i = 0 ; i < points.size() ; i++ )
+    {
+        if ( ! success[i] || commands[i] != &_bbCommand || ! isFeasible( outputs[i] ) || ! outputs[i][obj].is_defined() )
+            continue;
+        
+        // Already replicated (the cache has the mean objective)
+        if ( _cache->findStatistics( keys[i] , statistics[i] ) )
+            replicated[i] = 1;
+        else
+            candidate[i] = 1;
+        
+        if ( ! bestF.is_defined() || outputs[i][obj] < bestF )
+            bestF = outputs[i][obj];
+    }
+    
+    // Promising points: better than the incumbent, or the best of the block when there is no incumbent yet
+    std::vector<std::function<void()>> jobs;
+    std::vector<double> costs;
+    for ( size_t i = 0 ; i < points.size() ; i++ )
+    {
+        if ( ! candidate[i] )
+            continue;
+        
+        if ( _hasIncumbent ? ( outputs[i][obj] >= _incumbent.mean ) : ( outputs[i][obj] > bestF ) )
+            continue;
+        
+        statistics[i].add( outputs[i][obj].value() );
+        replicated[i] = 1;
+        
+        // Seeds 1..n-1 (the first evaluation has seed 0)
+        replicationOutputs[i].assign( _replications - 1 , NOMAD::Point() );
+        replicationSuccess[i].assign( _replications - 1 , 0 );
+        double cost = _costModel->predict( *points[i] );
+        for ( size_t k = 0 ; k < _replications - 1 ; k++ )
+        {
+            jobs.push_back( [this,i,k,&points,&commands,&replicationOutputs,&replicationSuccess]()
+            {
+                if ( launchAndObserve( *commands[i] , *points[i] , replicationOutputs[i][k] , static_cast<int>( k + 1 ) ) )
+                    replicationSuccess[i][k] = 1;
+            });
+            costs.push_back( cost );
+        }
+    }
+    
+    _workerPool->runLongestFirst( jobs , costs );
+    _nbReplications += jobs.size();
+    
+    // Aggregate the objective of the successful replications
+    for ( size_t i = 0 ; i < points.size() ; i++ )
+    {
+        if ( replicationOutputs[i].empty() )
+            continue;
+        
+        for ( size_t k = 0 ; k < replicationOutputs[i].size() ; k++ )
+        {
+            if ( replicationSuccess[i][k] && replicationOutputs[i][k][obj].is_defined() )
+                statistics[i].add( replicationOutputs[i][k][obj].value() );
+        }
+        outputs[i][obj] = statistics[i].mean;
+        
+        // The cache has the outputs of the blackbox
+        NOMAD::Point blackboxOutputs;
+        if ( _cache->find( keys[i] , blackboxOutputs ) )
+        {
+            blackboxOutputs[obj] = statistics[i].mean;
+            _cache->insert( keys[i] , blackboxOutputs );
+        }
+        _cache->insertStatistics( keys[i] , statistics[i] );
+    }
+    
+    // Statistical acceptance in the order of the block
+    for ( size_t i = 0 ; i < points.size() ; i++ )
+    {
+        if ( ! replicated[i] )
+            continue;
+        
+        if ( ! _hasIncumbent || ReplicationStatistics::isSignificantlyLower( statistics[i] , _incumbent ) )
+        {
+            _incumbent = statistics[i];
+            _hasIncumbent = true;
+        }
+        else if ( outputs[i][obj] < _incumbent.mean )
+            outputs[i][obj] = _incumbent.mean;
+    }
+    
+    return jobs.size();
+}
+
+std::list<bool> HyperEvaluator::eval_x ( std::list<NOMAD::Eval_Point *> & list_x , const NOMAD::Double & /*h_max*/ , std::list<bool> & list_count_eval ) const
+{
+    std::vector<NOMAD::Eval_Point *> evalPoints ( list_x.begin() , list_x.end() );
+    std::vector<const NOMAD::Point *> points;
+    std::vector<const std::string *> commands;
+    for ( auto x : evalPoints )
+    {
+        points.push_back( x );
+        commands.push_back( &getCommand( *x ) );
+    }
+    
+    std::vector<NOMAD::Point> outputs;
+    std::vector<char> success , countEval;
+    evaluateBlock( points , commands , outputs , success , countEval );
+    
+    list_count_eval.clear();
+    std::list<bool> list_success;
+    for ( size_t i = 0 ; i < evalPoints.size() ; i++ )
+    {
+        if ( success[i] )
+        {
+            for ( int j = 0 ; j < outputs[i].size() ; j++ )
+                evalPoints[i]->set_bb_output( j , outputs[i][j] );
+        }
+        list_success.push_back( success[i] != 0 );
+        list_count_eval.push_back( countEval[i] != 0 );
+    }
+    return list_success;
+}
+
+void HyperEvaluator::list_of_points_preprocessing ( std::set<NOMAD::Priority_Eval_Point> & list_of_points ) const
+{
+    // Only the candidates of the extended poll are sorted: their structures (signatures) differ and so do their costs.
+    // The poll and the search keep the order of Nomad (the points of a structure have close costs).
+    if ( list_of_points.empty() )
+        return;
+    const NOMAD::Signature * signature = list_of_points.begin()->get_point()->get_signature();
+    bool extendedPoll = false;
+    for ( const auto & point : list_of_points )
+    {
+        if ( point.get_point()->get_signature() != signature )
+        {
+            extendedPoll = true;
+            break;
+        }
+    }
+    if ( ! extendedPoll )
+        return;
+    
+    // Expected improvement per second: there is no model of the objective, the improvement expected from each candidate
+    // is the same and the priority is the inverse of the predicted time. The points are inserted again to be sorted.
+    std::vector<NOMAD::Priority_Eval_Point> points ( list_of_points.begin() , list_of_points.end() );
+    for ( const auto & point : points )
+    {
+        NOMAD::Eval_Point * x = const_cast<NOMAD::Eval_Point *>( point.get_point() );
+        x->set_user_eval_priority( 1.0 / std::max( _costModel->predict( *x ) , 1e-12 ) );
+    }
+    list_of_points.clear();
+    list_of_points.insert( points.begin() , points.end() );
+}
+
+size_t HyperEvaluator::evaluate ( const std::vector<NOMAD::Point> & points , std::vector<NOMAD::Point> & outputs ) const
+{
+    std::vector<const NOMAD::Point *> pointers;
+    for ( const auto & x : points )
+        pointers.push_back( &x );
+    std::vector<const std::string *> commands ( points.size() , &_bbCommand );
+    
+    std::vector<char> success , countEval;
+    size_t nbEval = evaluateBlock( pointers , commands , outputs , success , countEval );
+    
+    for ( size_t i = 0 ; i < points.size() ; i++ )
+    {
+        if ( ! success[i] )
+            outputs[i] = NOMAD::Point();
+        if ( countEval[i] )
+            nbEval++;
+    }
+    return nbEval;
+}
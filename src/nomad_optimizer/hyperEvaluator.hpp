@@ -0,0 +1,373 @@
+//
+//  hyperEvaluator.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __HYPEREVALUATOR__
+#define __HYPEREVALUATOR__
+
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+#include "syntheticBlackbox.hpp"
+#include "costModel.hpp"
+#include "architecture.hpp"
+#include "paretoArchive.hpp"
+#include "sharedMemoryRing.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+
+// Statistics of the objective over the replicated evaluations of a point (different seeds)
+struct ReplicationStatistics
+{
+    size_t n = 0;
+    double mean = 0;
+    double m2 = 0; // Sum of squared deviations from the mean (Welford)
+    
+    void add ( double f );
+    
+    double variance ( void ) const { return ( n > 1 ) ? m2 / ( n - 1 ) : 0; }
+    
+    // One-sided Welch t-test at 95%: true if the mean of a is lower than the mean of b.
+    // Means are simply compared when the variance cannot be estimated.
+    static bool isSignificantlyLower ( const ReplicationStatistics & a , const ReplicationStatistics & b );
+};
+
+// Outputs of evaluated points. The key contains the blackbox command and the point.
+// It can be shared by several campaigns (batch mode) and is accessed by several workers.
+// The outputs of a replicated point have the mean objective and the statistics are kept.
+class EvaluationCache
+{
+private:
+    std::map<std::string,NOMAD::Point> _outputs;
+    std::map<std::string,ReplicationStatistics> _statistics;
+    mutable std::mutex _mutex;
+    mutable size_t _nbHits = 0;
+
+public:
+
+    static std::string key ( const std::string & command , const NOMAD::Point & x );
+
+    bool find ( const std::string & key , NOMAD::Point & outputs ) const;
+    void insert ( const std::string & key , const NOMAD::Point & outputs );
+    
+    bool findStatistics ( const std::string & key , ReplicationStatistics & statistics ) const;
+    void insertStatistics ( const std::string & key , const ReplicationStatistics & statistics );
+
+    size_t size ( void ) const;
+    size_t getNbHits ( void ) const;
+};
+
+// Run jobs (blackbox launches) concurrently on a fixed number of workers.
+// A single pool is shared by all the campaigns of a batch.
+class WorkerPool
+{
+private:
+    size_t _nbWorkers;
+
+    // Campaigns are allowed to run blocks of jobs one at a time
+    mutable std::mutex _runMutex;
+
+public:
+
+    explicit WorkerPool ( size_t nbWorkers ) : _nbWorkers( ( nbWorkers > 0 ) ? nbWorkers : 1 ) {}
+
+    size_t getNbWorkers ( void ) const { return _nbWorkers; }
+
+    // Run all the jobs and return when they are all done
+    void run ( const std::vector<std::function<void()>> & jobs ) const;
+    
+    // Same with the longest predicted jobs started first (better packing when there are more jobs than workers)
+    void runLongestFirst ( const std::vector<std::function<void()>> & jobs , const std::vector<double> & costs ) const;
+
+    // Run a shell command and get its standard output. Return false if the command cannot be launched.
+    static bool runCommand ( const std::string & command , std::string & output );
+    
+    // Same with variables added to the environment of the command and a time budget in seconds (none if 0): the command and
+    // its processes are killed when the budget is exceeded (timedOut is true and false is returned). No time budget on Windows.
+    static bool runCommand ( const std::string & command , const Environment & environment , std::string & output , double timeout , bool & timedOut );
+};
+
+// Evaluation of points by launching the blackbox command (BB_EXE or SGTE_EXE followed by an input file)
+// as Nomad does, but with blocks of points dispatched to a worker pool and a cache of outputs.
+// A synthetic blackbox (see SyntheticBlackbox) is evaluated in process for both BB_EXE and SGTE_EXE.
+// With BB_TRANSFER SHARED_MEMORY, the points of BB_EXE are given to persistent workers (see SharedMemoryRing).
+// With MAX_EVAL_TIME, an evaluation of BB_EXE is killed after its time budget: it fails and is recorded as censored.
+// With CO_SCHEDULING, small networks of a block with the same batch size are trained together by one launch of the default blackbox.
+// With REPLICATIONS n, a feasible point better than the incumbent is evaluated n times with seeds 0..n-1
+// (HYPERNOMAD_SEED environment variable). Its objective is the mean and it becomes the incumbent only if
+// it is significantly better. Otherwise, its objective is held at the incumbent value so that Nomad does not move.
+// A point giving a network that cannot be built (see Architecture::checkShapes) is a failed evaluation and nothing is launched.
+// The size outputs (SECOND_OBJECTIVE PARAMETERS|MEMORY, MAX_PARAMETERS, MAX_MEMORY) are the last outputs and are computed from
+// the network. A point violating an EB size constraint is also a failed evaluation. The extra outputs (SECOND_OBJECTIVE TRAINING_TIME|LATENCY,
+// MAX_LATENCY) are requested from the blackbox. The cache only keeps the outputs of the blackbox as they are given.
+// With a second objective, the feasible points evaluated with BB_EXE are inserted in a Pareto archive written after each block.
+// A host process can evaluate the points itself with a callback (see Campaign): it replaces the blackbox command.
+class HyperEvaluator : public NOMAD::Evaluator
+{
+public:
+    
+    // Evaluation of a point in process: the outputs of the blackbox are given in outputs (one per output of BB_OUTPUT_TYPE
+    // except the size outputs computed by HyperNOMAD). The seed is negative if none is given (see REPLICATIONS).
+    // Return false if the evaluation failed. The callback is called simultaneously by the workers (BB_MAX_BLOCK_SIZE):
+    // it must be thread-safe. It is also called for the surrogate and it is not stopped after MAX_EVAL_TIME.
+    typedef std::function<bool ( const NOMAD::Point & x , NOMAD::Point & outputs , int seed )> Callback;
+    
+    // A successful evaluation of BB_EXE (a line of the history file)
+    struct Evaluation
+    {
+        NOMAD::Point x;
+        NOMAD::Point outputs;
+    };
+    
+private:
+
+    std::shared_ptr<WorkerPool> _workerPool;
+    std::shared_ptr<EvaluationCache> _cache;
+
+    std::string _bbCommand;
+    std::string _sgteCommand;
+    
+    // Environment of the blackbox: outputs requested after the objective and maximum number of epochs.
+    // Its text is part of the cache key.
+    Environment _environment;
+    std::string _environmentKey;
+
+    std::vector<NOMAD::bb_output_type> _bbot;
+    size_t _nbOutputs;
+    size_t _nbBlackboxOutputs;
+    size_t _objIndex;
+    size_t _secondObjIndex; // Same as _objIndex with a single objective
+    
+    size_t _replications;
+    mutable std::atomic<size_t> _nbReplications;
+    
+    // Small networks trained together by the default blackbox (CO_SCHEDULING)
+    size_t _coSchedulingNetworks;
+    double _coSchedulingMaxParameters;
+    
+    // Statistics of the incumbent (replicated points only)
+    mutable bool _hasIncumbent;
+    mutable ReplicationStatistics _incumbent;
+    
+    // In process blackbox for BB_EXE synthetic:... (null for a command)
+    std::shared_ptr<SyntheticBlackbox> _synthetic;
+    
+    // In process evaluation by the host process (replaces the command and the synthetic blackbox if set)
+    Callback _callback;
+    
+    // Persistent workers of BB_EXE (BB_TRANSFER SHARED_MEMORY, null otherwise)
+    std::shared_ptr<SharedMemoryRing> _sharedMemoryRing;
+    
+    // Wall time of the blackbox evaluations (learned from the launches)
+    std::shared_ptr<CostModel> _costModel;
+    
+    // To decode the networks
+    std::vector<HyperParameters::BlockLayout> _layout;
+    std::string _dataset;
+    std::vector<HyperParameters::SizeOutput> _sizeOutputs;
+    std::vector<HyperParameters::ExtraOutput> _extraOutputs;
+    mutable std::atomic<size_t> _nbRejected;
+    
+    // Time budget of an evaluation (MAX_EVAL_TIME) and wall times of the completed evaluations for the adaptive budget
+    double _maxEvalTime;
+    double _evalTimeMedianFactor;
+    mutable std::vector<double> _evaluationTimes;
+    mutable std::mutex _evaluationTimesMutex;
+    mutable std::atomic<size_t> _nbTimedOut;
+    
+    // Evaluations stopped after their time budget (coordinates followed by ">= budget")
+    mutable std::ofstream _censored;
+    
+    // Non dominated points (bi-objective only) and the file where it is written
+    std::shared_ptr<ParetoArchive> _paretoArchive;
+    std::string _paretoFileName;
+    
+    // Points evaluated with BB_EXE and their outputs (one line per evaluation as the history file of Nomad)
+    mutable std::ofstream _history;
+    
+    // Metrics of each epoch written by the blackbox (HYPERNOMAD_TRACE), prefixed by the number of the evaluation in the history
+    mutable std::ofstream _traces;
+    mutable size_t _nbRecorded;
+    
+    // Same evaluations as the history file kept in memory (read by other threads during a run)
+    mutable std::vector<Evaluation> _evaluations;
+    mutable std::mutex _evaluationsMutex;
+    
+    // Evaluations of BB_EXE counted by Nomad (failed ones included, cache hits and replications excluded)
+    mutable std::atomic<size_t> _nbEval;
+
+    // What is known of a launch besides its outputs
+    struct LaunchRecord
+    {
+        std::string trace;      // Training trace written by the blackbox
+        double censoredTime;    // Time budget if the blackbox was stopped (its time is at least this), 0 otherwise
+        LaunchRecord ( void ) : censoredTime ( 0 ) {}
+    };
+    
+    // Time budget in seconds of an evaluation of BB_EXE (0: none). The adaptive budget needs 5 completed evaluations.
+    double getTimeBudget ( void ) const;
+    
+    // Give the wall time of an evaluation to the cost model and to the adaptive time budget (a censored time is only given to the cost model)
+    void observe ( const NOMAD::Point & x , double seconds , bool censored = false ) const;
+    
+    // Launch the blackbox for a point and read the outputs. A seed is given to the blackbox if not negative.
+    // The training trace and the censoring are given in record if it is not null.
+    bool launch ( const std::string & command , const NOMAD::Point & x , NOMAD::Point & outputs , int seed = -1 , LaunchRecord * record = nullptr ) const;
+    
+    // Launch the default blackbox once for a pack of points given by their indices in the block: one line per point
+    // in the input file and one line of outputs per point. The wall time and the time budget are shared between the points.
+    void launchPack ( const std::vector<size_t> & pack , const std::vector<const NOMAD::Point *> & points , std::vector<NOMAD::Point> & outputs , std::vector<char> & success , int seed , std::vector<LaunchRecord> & records ) const;
+    
+    // Packs of points launched together (indices in the block). A pack has small networks with the same batch size (they
+    // share the data batches). Packs are made only when there are more launches than workers: the workers are kept busy.
+    std::vector<std::vector<size_t>> coSchedule ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , const std::vector<size_t> & launched ) const;
+    
+    // Launch and give the wall time of a successful blackbox evaluation to the cost model
+    bool launchAndObserve ( const std::string & command , const NOMAD::Point & x , NOMAD::Point & outputs , int seed , LaunchRecord * record = nullptr ) const;
+    
+    // Write the evaluations of a block launched with BB_EXE in the history with their training traces, and the censored evaluations
+    void record ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , const std::vector<NOMAD::Point> & outputs , const std::vector<char> & success , const std::vector<char> & countEval , const std::vector<LaunchRecord> & records ) const;
+    
+    bool isFeasible ( const NOMAD::Point & outputs ) const;
+    
+    // Check the network of a point and compute the size constraints (relative excess over the bounds).
+    // Return false if the blackbox must not be launched (network cannot be built or EB size constraint violated).
+    bool precheck ( const NOMAD::Point & x , std::vector<NOMAD::Double> & sizeOutputs ) const;
+    
+    // Outputs given to Nomad: outputs of the blackbox (extra constraints relative to their bound) followed by the size outputs
+    NOMAD::Point completeOutputs ( const NOMAD::Point & blackboxOutputs , const std::vector<NOMAD::Double> & sizeOutputs ) const;
+
+    const std::string & getCommand ( const NOMAD::Eval_Point & x ) const ;
+    
+    // Evaluate a block of points on the workers (cache first). Return the number of replicated evaluations.
+    size_t evaluateBlock ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , std::vector<NOMAD::Point> & outputs , std::vector<char> & success , std::vector<char> & countEval ) const;
+    
+    // Insert the feasible points of a block in the Pareto archive and write it if it changed
+    void updateParetoArchive ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , const std::vector<NOMAD::Point> & outputs , const std::vector<char> & success ) const;
+    
+    // Replicate the promising points of a block and apply the statistical acceptance of the incumbent
+    size_t replicate ( const std::vector<const NOMAD::Point *> & points , const std::vector<const std::string *> & commands , const std::vector<std::string> & keys , std::vector<NOMAD::Point> & outputs , const std::vector<char> & success ) const;
+
+public:
+
+    HyperEvaluator ( const NOMAD::Parameters & p , const HyperParameters & hyperParameters , std::shared_ptr<WorkerPool> workerPool , std::shared_ptr<EvaluationCache> cache );
+
+    virtual ~HyperEvaluator ( void ) {}
+
+    virtual bool eval_x ( NOMAD::Eval_Point & x , const NOMAD::Double & h_max , bool & count_eval ) const ;
+
+    virtual std::list<bool> eval_x ( std::list<NOMAD::Eval_Point *> & list_x , const NOMAD::Double & h_max , std::list<bool> & list_count_eval ) const ;
+    
+    // Called by Nomad before the evaluation of a list of points. The candidates of the extended poll (several structures)
+    // are sorted by expected improvement per second with the user priority of Nomad, so that the opportunistic evaluation
+    // tries the cheapest predicted structures first. The poll and the search keep the order of Nomad.
+    virtual void list_of_points_preprocessing ( std::set<NOMAD::Priority_Eval_Point> & list_of_points ) const ;
+    
+    // Evaluate points of any dimension with the blackbox in a single block (used outside of Mads).
+    // The outputs of a failed evaluation are empty. Return the number of blackbox evaluations (replications included).
+    size_t evaluate ( const std::vector<NOMAD::Point> & points , std::vector<NOMAD::Point> & outputs ) const;
+
+    const CostModel & getCostModel ( void ) const { return *_costModel; }
+    
+    // Evaluate the points with a callback instead of the blackbox (set before the first evaluation)
+    void setCallback ( Callback callback );
+    
+    // No blackbox executable: synthetic blackbox or callback
+    bool isInProcess ( void ) const { return _synthetic || _callback; }
+    
+    // Successful evaluations of BB_EXE in the order of the history
+    std::vector<Evaluation> getEvaluations ( void ) const;
+    size_t getNbEvaluations ( void ) const;
+    
+    // Number of evaluations of BB_EXE counted in MAX_BB_EVAL
+    size_t getNbEval ( void ) const { return _nbEval; }
+    
+    // Number of points rejected without launching the blackbox
+    size_t getNbRejected ( void ) const { return _nbRejected; }
+    
+    // Number of evaluations launched for replications (not counted by Nomad)
+    size_t getNbReplications ( void ) const { return _nbReplications; }
+    
+    // Write the history of the evaluations (values are read back exactly)
+    void setHistoryFile ( const std::string & fileName );
+    
+    // Number of evaluations stopped after their time budget (MAX_EVAL_TIME)
+    size_t getNbTimedOut ( void ) const { return _nbTimedOut; }
+    
+    // Write the evaluations stopped after their time budget
+    void setCensoredFile ( const std::string & fileName );
+    
+    // Collect the training traces of the evaluations (CSV, one line per epoch)
+    void setTraceFile ( const std::string & fileName );
+    
+    // Keep the non dominated points in an archive written in a file if a name is given (two objectives required)
+    void setParetoArchive ( std::shared_ptr<ParetoArchive> paretoArchive , const std::string & fileName );
+    
+    // Values separated by spaces without loss of precision (undefined values are -)
+    static void writeValues ( std::ostream & out , const NOMAD::Point & x );
+    
+    // Remove the $ used in Nomad to prevent adding the problem directory to a command
+    static std::string toShellCommand ( const std::string & bbExe );
+    
+    // Output types that are constraints (a positive value is infeasible)
+    static bool isConstraint ( NOMAD::bb_output_type bbot );
+
+};
+
+// Evaluator given to Nomad for a bi-objective optimization (BiMads requires a Multi_Obj_Evaluator).
+// The evaluations are done by a HyperEvaluator.
+class HyperMultiObjEvaluator : public NOMAD::Multi_Obj_Evaluator
+{
+private:
+    
+    const HyperEvaluator & _ev;
+    
+public:
+    
+    HyperMultiObjEvaluator ( const NOMAD::Parameters & p , const HyperEvaluator & ev ) : NOMAD::Multi_Obj_Evaluator ( p ) , _ev ( ev ) {}
+    
+    virtual ~HyperMultiObjEvaluator ( void ) {}
+    
+    virtual bool eval_x ( NOMAD::Eval_Point & x , const NOMAD::Double & h_max , bool & count_eval ) const
+    {
+        return _ev.eval_x( x , h_max , count_eval );
+    }
+    
+    virtual std::list<bool> eval_x ( std::list<NOMAD::Eval_Point *> & list_x , const NOMAD::Double & h_max , std::list<bool> & list_count_eval ) const
+    {
+        return _ev.eval_x( list_x , h_max , list_count_eval );
+    }
+    
+    virtual void list_of_points_preprocessing ( std::set<NOMAD::Priority_Eval_Point> & list_of_points ) const
+    {
+        _ev.list_of_points_preprocessing( list_of_points );
+    }
+};
+
+#endif
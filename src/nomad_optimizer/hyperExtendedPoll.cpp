@@ -0,0 +1,65 @@
+//
+//  hyperExtendedPoll.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "hyperExtendedPoll.hpp"
+
+/*--------------------------------------*/
+/*  construct the extended poll points  */
+/*      (categorical neighborhoods)     */
+/*--------------------------------------*/
+void HyperExtendedPoll::construct_extended_points ( const NOMAD::Eval_Point & x)
+{
+
+    // Get the neighboors of the point (an update of the hyper parameters structure is performed)
+    std::vector<HyperParameters> neighboors = _hyperParameters->getNeighboors(x);
+
+    for ( auto & nHyperParameters : neighboors )
+    {
+        // Create a parameter to obtain a signature for this neighboor
+        NOMAD::Parameters nP ( _p.out() );
+        setNeighboorParameters( nHyperParameters , _p , nP );
+
+        // The signature to be registered with the neighboor point
+        NOMAD::Point nX = nHyperParameters.getValues( ValueType::CURRENT_VALUE );
+        add_extended_poll_point ( nX , *(nP.get_signature()) );
+    }
+}
+
+void HyperExtendedPoll::setNeighboorParameters ( const HyperParameters & nHyperParameters , const NOMAD::Parameters & p , NOMAD::Parameters & nP )
+{
+    size_t nDim = nHyperParameters.getDimension();
+    std::vector<NOMAD::bb_input_type> nBbit = nHyperParameters.getTypes();
+
+    NOMAD::Point nLowerBound = nHyperParameters.getValues( ValueType::LOWER_BOUND );
+    NOMAD::Point nUpperBound = nHyperParameters.getValues( ValueType::UPPER_BOUND );
+    NOMAD::Point nX = nHyperParameters.getValues( ValueType::CURRENT_VALUE );
+
+    nP.set_DIMENSION( static_cast<int>(nDim) );
+    nP.set_X0 ( nX );
+    nP.set_LOWER_BOUND( nLowerBound );
+    nP.set_UPPER_BOUND( nUpperBound );
+
+    nP.set_BB_INPUT_TYPE( nBbit );
+    nP.set_MESH_TYPE( NOMAD::XMESH );  // Need to force set XMesh
+
+    std::vector<size_t> indexFixed = nHyperParameters.getIndexFixedParams();
+    for ( auto i : indexFixed )
+        nP.set_FIXED_VARIABLE( static_cast<int>(i) );
+
+    // Each block forms a NOMAD VARIABLE GROUP
+    std::vector<std::set<int>> variableGroupsIndices = nHyperParameters.getVariableGroupsIndices();
+    for ( auto aGroupIndices : variableGroupsIndices )
+        nP.set_VARIABLE_GROUP( aGroupIndices );
+
+
+    // Some parameters come from the original problem definition (no BB_EXE for a synthetic blackbox)
+    nP.set_BB_OUTPUT_TYPE( p.get_bb_output_type() );
+    if ( ! p.get_bb_exe().empty() )
+        nP.set_BB_EXE( p.get_bb_exe() );
+    // Check is need to create a valid signature
+    nP.check();
+}
@@ -0,0 +1,65 @@
+//
+//  hyperExtendedPoll.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __HYPEREXTENDEDPOLL__
+#define __HYPEREXTENDEDPOLL__
+
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+
+#include <memory>
+
+/*--------------------------------------------------*/
+/*  user class to define categorical neighborhoods  */
+/*--------------------------------------------------*/
+class HyperExtendedPoll : public NOMAD::Extended_Poll
+{
+
+private:
+
+    std::shared_ptr<HyperParameters> _hyperParameters;
+
+public:
+
+    // constructor:
+    HyperExtendedPoll ( NOMAD::Parameters & p , std::shared_ptr<HyperParameters> hyperParameters ):
+    NOMAD::Extended_Poll ( p ), _hyperParameters(std::move(hyperParameters))
+    {
+    }
+
+    // destructor:
+    virtual ~HyperExtendedPoll ( void ) {}
+
+    // construct the extended poll points:
+    virtual void construct_extended_points ( const NOMAD::Eval_Point &);
+
+    // Set and check the parameters giving the signature of a neighboor.
+    // Some parameters come from the original problem definition p.
+    static void setNeighboorParameters ( const HyperParameters & neighboor , const NOMAD::Parameters & p , NOMAD::Parameters & nP );
+
+};
+
+#endif
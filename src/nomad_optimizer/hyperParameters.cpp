@@ -7,21 +7,23 @@
 //
 
 #include "hyperParameters.hpp"
+#include "defaultSchema.hpp"
 
-void trimLeft( NOMAD::Point & x )
+#include <fstream>
+#include <sstream>
+
+HyperParameters::PointReader::PointReader ( const NOMAD::Point & x ) : _x ( x ) , _next ( 0 ) , _end ( static_cast<size_t>(x.size()) )
 {
-    if ( x.size() == 1 )
-    {
-        x = NOMAD::Point();
-        return;
-    }
+    while ( _end > 0 && ! _x[static_cast<int>(_end-1)].is_defined() )
+        _end--;
+}
+
+const NOMAD::Double & HyperParameters::PointReader::next ( )
+{
+    if ( _next >= static_cast<size_t>(_x.size()) )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ ,"HyperParameters: Cannot update because the structure of hyperparameters is not consistent with the size of the point." );
     
-    NOMAD::Point xTrimmed ( static_cast<int>(x.size() - 1) );
-    for ( size_t i=0 ; i < xTrimmed.size(); i++ )
-    {
-        xTrimmed[i]=x[i+1];
-    }
-    x = xTrimmed;
+    return _x[static_cast<int>(_next++)];
 }
 
 std::vector<NOMAD::bb_input_type> HyperParameters::getTypes() const
@@ -97,7 +99,7 @@ std::vector<size_t> HyperParameters::getIndexFixedParams() const
     
     size_t current_index =0;
     std::vector<size_t> fixedParams;
-    for ( auto aBlock : _expandedHyperParameters )
+    for ( const auto & aBlock : _expandedHyperParameters )
     {
         std::vector<size_t> blockFixedParams = aBlock.getIndexFixedParams( current_index );
         fixedParams.insert( fixedParams.begin() , blockFixedParams.begin() , blockFixedParams.end() );
@@ -109,17 +111,23 @@ std::vector<std::set<int>> HyperParameters:: getVariableGroupsIndices() const
 {
     int current_index =0;
     std::vector<std::set<int>> indices;
-    for ( auto aBlock : _expandedHyperParameters )
+    for ( const auto & aBlock : _expandedHyperParameters )
     {
         std::set<int> aGroupIndices;
-        std::vector<NOMAD::bb_input_type> bbit = aBlock.getTypes ( );
-        for ( size_t i = 0 ; i < bbit.size() ; i++, current_index++ )
+        
+        // Fixed and categorical hyperparameters cannot be part of a Nomad group of variables
+        auto insertIfVariable = [&]( const GenericHyperParameter & aHP )
         {
-            // Fixed and categorical hyperparameters cannot be part of a Nomad group of variables
-            //
-            if ( bbit[i] != NOMAD::CATEGORICAL && ! aBlock.getHyperParameter(i).isFixed )
-                aGroupIndices.insert(current_index);
-        }
+            if ( aHP.type != NOMAD::CATEGORICAL && ! aHP.isFixed )
+                aGroupIndices.insert( aGroupIndices.end() , current_index );
+            current_index++;
+        };
+        
+        // Same order as getTypes: head then associated hyperparameters
+        insertIfVariable( aBlock.headOfBlockHyperParameter );
+        for ( const auto & groupAHP : aBlock.groupsOfAssociatedHyperParameters )
+            for ( const auto & aHP : groupAHP )
+                insertIfVariable( aHP );
         if ( aGroupIndices.size() > 0 )
             indices.push_back( aGroupIndices );
     }
@@ -138,21 +146,13 @@ void HyperParameters::updateFromBaseAndPerformExpansion( const NOMAD::Point & x
         throw NOMAD::Exception ( __FILE__ , __LINE__ ,"HyperParameters: Cannot update because the hyperparameters structure has not been expanded" );
     }
     
-    // Set undefined vectors
-    NOMAD::Point xBlock;
-    NOMAD::Point lbBlock;
-    NOMAD::Point ubBlock;
-    
-    
-    
-    if ( explicitSetX0 )
-        xBlock = x;
+    // Undefined vectors are not read
+    NOMAD::Point undefinedPoint;
     
     // LowerBounds and UpperBounds are fixed
-    if ( explicitSetLowerBounds )
-        lbBlock = _lowerBound ;
-    if ( explicitSetUpperBounds )
-        ubBlock = _upperBound;
+    PointReader xBlock ( explicitSetX0 ? x : undefinedPoint );
+    PointReader lbBlock ( explicitSetLowerBounds ? _lowerBound : undefinedPoint );
+    PointReader ubBlock ( explicitSetUpperBounds ? _upperBound : undefinedPoint );
     
     for ( auto & block : _expandedHyperParameters )
     {
@@ -160,33 +160,24 @@ void HyperParameters::updateFromBaseAndPerformExpansion( const NOMAD::Point & x
         if ( block.headOfBlockHyperParameter.isDefined() )
         {
             if ( explicitSetX0 )
-            {
-                block.headOfBlockHyperParameter.value = xBlock[0];
-                trimLeft( xBlock );
-            }
+                block.headOfBlockHyperParameter.value = xBlock.next();
             if ( explicitSetLowerBounds )
-            {
-                block.headOfBlockHyperParameter.lowerBoundValue = lbBlock[0];
-                trimLeft( lbBlock );
-            }
+                block.headOfBlockHyperParameter.lowerBoundValue = lbBlock.next();
             if ( explicitSetUpperBounds)
-            {
-                block.headOfBlockHyperParameter.upperBoundValue = ubBlock[0];
-                trimLeft( ubBlock );
-            }
+                block.headOfBlockHyperParameter.upperBoundValue = ubBlock.next();
         }
         else
             throw NOMAD::Exception ( __FILE__ , __LINE__ ,"HyperParameters: Cannot update because the head of block does not exist." );
         
         // Expand the block structure from the updated head value
         // Set the flags for dynamic fixed variables
-        // update the associated parameters with xBlock value and trim xBlock for next block
+        // update the associated parameters with xBlock value and move forward for next block
         block.expandAssociatedParameters();
         block.updateAssociatedParameters ( xBlock ,lbBlock , ubBlock );
         
         
     }
-    if ( xBlock.size() != 0 )
+    if ( xBlock.remaining() != 0 )
     {
         throw NOMAD::Exception ( __FILE__ , __LINE__ ,"HyperParameters: Cannot update because the structure of hyperparameters is not consistent with the size of the point." );
     }
@@ -215,7 +206,7 @@ std::vector<HyperParameters> HyperParameters::getNeighboors( const NOMAD::Point
         
         // Get the neighboors for a given block of hyperparameters
         // The neighboors are expanded
-        std::vector<HyperParametersBlock> nBlocks= _expandedHyperParameters[i].getNeighboorsOfBlock ( );
+        std::vector<HyperParametersBlock> nBlocks= _expandedHyperParameters[i].getNeighboorsOfBlock ( _neighborhoodOptions );
         
         // For each neighboor block: insert base blocks of hyperparameters before and after
         for ( auto & aNBlock : nBlocks )
@@ -241,17 +232,255 @@ std::vector<HyperParameters> HyperParameters::getNeighboors( const NOMAD::Point
     return neighboors;
 }
 
+// Latin hypercube sample of the hyperparameters, including the head of blocks that change the structure.
+// Each design point has its own structure. The current structure (X0) gives the fixed values.
+std::vector<NOMAD::Point> HyperParameters::getInitialDesign ( void ) const
+{
+    std::vector<NOMAD::Point> design;
+    
+    const size_t n = _initialDesignSize;
+    if ( n == 0 )
+        return design;
+    
+    std::mt19937 rng ( 0 );
+    std::uniform_real_distribution<double> uniform ( 0.0 , 1.0 );
+    
+    // A random permutation of the n strata for each (block, group, position) taken by a hyperparameter in the design
+    std::map<std::tuple<size_t,size_t,size_t>,std::vector<size_t>> strata;
+    
+    auto sample = [&]( const GenericHyperParameter & aHP , const std::tuple<size_t,size_t,size_t> & key , size_t k ) -> NOMAD::Double
+    {
+        if ( aHP.isFixed || ! aHP.lowerBoundValue.is_defined() || ! aHP.upperBoundValue.is_defined() )
+            return aHP.value;
+        
+        std::vector<size_t> & permutation = strata[key];
+        if ( permutation.empty() )
+        {
+            permutation.resize( n );
+            for ( size_t i = 0 ; i < n ; i++ )
+                permutation[i] = i;
+            std::shuffle( permutation.begin() , permutation.end() , rng );
+        }
+        
+        double lb = aHP.lowerBoundValue.value();
+        double ub = aHP.upperBoundValue.value();
+        double u = ( permutation[k] + uniform( rng ) ) / n;
+        
+        if ( aHP.type == NOMAD::CONTINUOUS )
+            return lb + u * ( ub - lb );
+        
+        // Integer values: each integer of [lb,ub] has the same width
+        return std::min( ub , lb + std::floor( u * ( ub - lb + 1 ) ) );
+    };
+    
+    // With LOWER_BOUND or UPPER_BOUND given for all variables, the dimension cannot change
+    bool sampleStructure = ! _explicitSetLowerBounds && ! _explicitSetUpperBounds;
+    
+    for ( size_t k = 0 ; k < n ; k++ )
+    {
+        std::vector<HyperParametersBlock> blocks = _expandedHyperParameters;
+        
+        std::vector<NOMAD::Double> x;
+        for ( size_t i = 0 ; i < blocks.size() ; i++ )
+        {
+            HyperParametersBlock & block = blocks[i];
+            GroupsOfAssociatedHyperParameters & groups = block.groupsOfAssociatedHyperParameters;
+            
+            if ( block.associatedParametersType != AssociatedHyperParametersType::MULTIPLE_TIMES || sampleStructure )
+                block.headOfBlockHyperParameter.value = sample( block.headOfBlockHyperParameter , std::make_tuple( i , 0 , 0 ) , k );
+            
+            // Number of groups given by the head value
+            if ( block.associatedParametersType == AssociatedHyperParametersType::MULTIPLE_TIMES )
+            {
+                size_t nbGroups = static_cast<size_t>( block.headOfBlockHyperParameter.value.round() );
+                if ( groups.size() > nbGroups )
+                    groups.resize( nbGroups );
+                while ( groups.size() < nbGroups )
+                    groups.push_back( block.updateAssociatedParameters( groups.empty() ? block.getDefaultGroupOfAssociatedParameters() : groups.back() ) );
+            }
+            
+            for ( size_t g = 0 ; g < groups.size() ; g++ )
+                for ( size_t j = 0 ; j < groups[g].size() ; j++ )
+                    groups[g][j].value = sample( groups[g][j] , std::make_tuple( i , g + 1 , j ) , k );
+            
+            std::vector<NOMAD::Double> blockValues = block.getValues( ValueType::CURRENT_VALUE );
+            x.insert( x.end() , blockValues.begin() , blockValues.end() );
+        }
+        
+        design.push_back( NOMAD::Point( static_cast<int>( x.size() ) ) );
+        for ( size_t i = 0 ; i < x.size() ; i++ )
+            design.back()[static_cast<int>(i)] = x[i];
+    }
+    return design;
+}
+
+// A point has the current structure if the head of blocks changing the structure have the same values
+bool HyperParameters::hasCurrentStructure ( const NOMAD::Point & x ) const
+{
+    size_t index = 0;
+    for ( const auto & block : _expandedHyperParameters )
+    {
+        if ( index >= static_cast<size_t>( x.size() ) )
+            return false;
+        
+        if ( block.associatedParametersType == AssociatedHyperParametersType::MULTIPLE_TIMES && x[static_cast<int>(index)] != block.headOfBlockHyperParameter.value )
+            return false;
+        
+        index += block.getDimension();
+    }
+    return ( index == static_cast<size_t>( x.size() ) );
+}
+
+// Point of another campaign (WARM_START) in the current search space. The values are rounded for integer hyperparameters
+// and clipped to the bounds, the fixed hyperparameters keep their value. The groups missing in x are copied as in the
+// initial design. With LOWER_BOUND or UPPER_BOUND given for all variables, the structure of X0 is kept.
+// Return false if x does not have the blocks of the schema.
+bool HyperParameters::projectPoint ( const NOMAD::Point & x , NOMAD::Point & projected ) const
+{
+    auto project = []( const GenericHyperParameter & aHP , const NOMAD::Double & v ) -> NOMAD::Double
+    {
+        if ( aHP.isFixed || ! v.is_defined() )
+            return aHP.value;
+        
+        NOMAD::Double p = ( aHP.type == NOMAD::CONTINUOUS ) ? v : NOMAD::Double( v.round() );
+        if ( aHP.lowerBoundValue.is_defined() && p < aHP.lowerBoundValue )
+            p = aHP.lowerBoundValue;
+        if ( aHP.upperBoundValue.is_defined() && p > aHP.upperBoundValue )
+            p = aHP.upperBoundValue;
+        return p;
+    };
+    
+    bool projectStructure = ! _explicitSetLowerBounds && ! _explicitSetUpperBounds;
+    
+    std::vector<HyperParametersBlock> blocks = _expandedHyperParameters;
+    
+    std::vector<NOMAD::Double> values;
+    size_t index = 0;
+    for ( auto & block : blocks )
+    {
+        GroupsOfAssociatedHyperParameters & groups = block.groupsOfAssociatedHyperParameters;
+        
+        if ( index >= static_cast<size_t>( x.size() ) || ! x[static_cast<int>(index)].is_defined() )
+            return false;
+        const NOMAD::Double & head = x[static_cast<int>(index++)];
+        
+        // Groups given in x
+        size_t groupSize = 0;
+        if ( block.associatedParametersType != AssociatedHyperParametersType::ZERO_TIME )
+            groupSize = ( groups.empty() ) ? block.getDefaultGroupOfAssociatedParameters().size() : groups[0].size();
+        size_t nbGroupsInX = ( groupSize == 0 ) ? 0 : 1;
+        if ( block.associatedParametersType == AssociatedHyperParametersType::MULTIPLE_TIMES )
+            nbGroupsInX = ( head.round() > 0 ) ? static_cast<size_t>( head.round() ) : 0;
+        if ( index + nbGroupsInX * groupSize > static_cast<size_t>( x.size() ) )
+            return false;
+        
+        if ( block.associatedParametersType != AssociatedHyperParametersType::MULTIPLE_TIMES || projectStructure )
+            block.headOfBlockHyperParameter.value = project( block.headOfBlockHyperParameter , head );
+        
+        if ( block.associatedParametersType == AssociatedHyperParametersType::MULTIPLE_TIMES )
+        {
+            size_t nbGroups = static_cast<size_t>( block.headOfBlockHyperParameter.value.round() );
+            if ( groups.size() > nbGroups )
+                groups.resize( nbGroups );
+            while ( groups.size() < nbGroups )
+                groups.push_back( block.updateAssociatedParameters( groups.empty() ? block.getDefaultGroupOfAssociatedParameters() : groups.back() ) );
+        }
+        
+        for ( size_t g = 0 ; g < groups.size() && g < nbGroupsInX ; g++ )
+            for ( size_t j = 0 ; j < groups[g].size() && j < groupSize ; j++ )
+                groups[g][j].value = project( groups[g][j] , x[static_cast<int>( index + g * groupSize + j )] );
+        index += nbGroupsInX * groupSize;
+        
+        std::vector<NOMAD::Double> blockValues = block.getValues( ValueType::CURRENT_VALUE );
+        values.insert( values.end() , blockValues.begin() , blockValues.end() );
+    }
+    if ( index != static_cast<size_t>( x.size() ) )
+        return false;
+    
+    projected = NOMAD::Point( static_cast<int>( values.size() ) );
+    for ( size_t i = 0 ; i < values.size() ; i++ )
+        projected[static_cast<int>(i)] = values[i];
+    return true;
+}
+
+// Change X0 after construction (for example, the best point of the initial design). The structure can change.
+void HyperParameters::setX0 ( const NOMAD::Point & x )
+{
+    _X0 = x;
+    _explicitSetX0 = true;
+    
+    // The initial values are set again by check() from the new X0
+    for ( auto & block : _baseHyperParameters )
+    {
+        block.headOfBlockHyperParameter.initialValue = NOMAD::Double();
+        for ( auto & group : block.groupsOfAssociatedHyperParameters )
+            for ( auto & aHP : group )
+                aHP.initialValue = NOMAD::Double();
+    }
+    
+    updateFromBaseAndPerformExpansion( _X0 , _explicitSetX0 , _explicitSetLowerBounds , _explicitSetUpperBounds );
+    check();
+}
+
+std::vector<HyperParameters::BlockLayout> HyperParameters::getBlockLayout ( void ) const
+{
+    std::vector<BlockLayout> layout;
+    for ( const auto & block : _baseHyperParameters )
+    {
+        BlockLayout blockLayout;
+        blockLayout.name = block.name;
+        blockLayout.multipleGroups = ( block.associatedParametersType == AssociatedHyperParametersType::MULTIPLE_TIMES );
+        blockLayout.headSearchName = block.headOfBlockHyperParameter.searchName;
+        blockLayout.headLowerBound = block.headOfBlockHyperParameter.lowerBoundValue;
+        blockLayout.headUpperBound = block.headOfBlockHyperParameter.upperBoundValue;
+        
+        blockLayout.groupSize = 0;
+        if ( block.associatedParametersType != AssociatedHyperParametersType::ZERO_TIME )
+        {
+            // The base group has the bounds set in the hyperparameters file
+            const std::vector<GenericHyperParameter> & group = block.groupsOfAssociatedHyperParameters.empty() ? block.getDefaultGroupOfAssociatedParameters() : block.groupsOfAssociatedHyperParameters[0];
+            for ( const auto & aHP : group )
+            {
+                blockLayout.searchNames.push_back( aHP.searchName );
+                blockLayout.lowerBounds.push_back( aHP.lowerBoundValue );
+                blockLayout.upperBounds.push_back( aHP.upperBoundValue );
+            }
+            blockLayout.groupSize = blockLayout.lowerBounds.size();
+        }
+        layout.push_back( blockLayout );
+    }
+    return layout;
+}
+
 HyperParameters::HyperParameters ( const std::string & hyperParamFileName , const std::string & pytorchBB, const std::string & pytorchSGTE )
 {
     // Default display
     _hyperDisplay = 1;
     _lhIterationSearch = 0;
+    _initialDesignSize = 0;
+    _replications = 1;
+    _coSchedulingNetworks = 1;
+    _coSchedulingMaxParameters = 0;
+    _maxEvalTime = 0;
+    _evalTimeMedianFactor = 0;
+    _maxEpochs = 0;
+    _warmStartPoints = 5;
     
     // BB_EXE minus the dataset name (dataset name is added during check
     _bbEXE = "$python " + pytorchBB;
     _sgteEXE = "$python " + pytorchSGTE;
     
-    initBlockStructureToDefault();
+    // Persistent worker next to the default blackbox (used with BB_TRANSFER SHARED_MEMORY)
+    _bbWorkerEXE = "$python " + extractDir( pytorchBB ) + "shm_worker.py";
+    _sharedMemoryTransfer = false;
+    _defaultBB = true;
+    
+    // The file is read first: it can give the schema of the block structure
+    HyperParametersFile hyperParamFile;
+    if ( ! hyperParamFileName.empty() )
+        hyperParamFile.read ( hyperParamFileName );
+    
+    initBlockStructure( hyperParamFile );
     
     registerSearchNames();
     
@@ -259,7 +488,7 @@ HyperParameters::HyperParameters ( const std::string & hyperParamFileName , cons
         std::cout << "WARNING: no hyperparameter file is provided, all values will be set to default." << std::endl;
     else
     {
-        read(hyperParamFileName);
+        read(hyperParamFile);
         updateAndCheckAfterReading();
     }
     
@@ -273,6 +502,17 @@ HyperParameters::HyperParameters ( const std::string & hyperParamFileName , cons
     // Perform check on hyperparameters and set initial value for both base and expanded
     check();
     
+    // The other starting points in the search space of X0 (bounds and fixed values)
+    for ( size_t k = 0 ; k < _otherX0s.size() ; k++ )
+    {
+        NOMAD::Point projected;
+        if ( ! projectPoint( _otherX0s[k] , projected ) )
+            throw NOMAD::Exception ( __FILE__ , __LINE__ , "Point " + std::to_string( k + 2 ) + " given with X0 is not consistent with the structure of hyperparameters" );
+        if ( projected != _otherX0s[k] )
+            std::cout << "WARNING: point " << k + 2 << " given with X0 is moved within the bounds or to the fixed values." << std::endl;
+        _otherX0s[k] = projected;
+    }
+    
     display();
 }
 
@@ -367,97 +607,35 @@ void HyperParameters::display () const
 
 // Sets some base hyperparameters value
 // Also set some Nomad optimization parameters (MAX_BB_EVAL, X0, BB_EXE)
-void HyperParameters::read (const std::string & hyperParamFileName )
+void HyperParameters::read ( const HyperParametersFile & file )
 {
-    //
-    // First read the file to set Nomad parameter entries
-    //
-    
-    std::ifstream fin;
-    std::string err = "Cannot read " + hyperParamFileName ;
-    if ( NOMAD::check_read_file ( hyperParamFileName ) )
-    {
-        fin.open ( hyperParamFileName.c_str() );
-        if ( !fin.fail() )
-            err.clear();
-    }
-    if ( !err.empty() )
-    {
-        fin.close();
-        throw NOMAD::Exception ( __FILE__ , __LINE__ , err );
-    }
-    
-    // the set of entries:
-    NOMAD::Parameter_Entries entries;
-    
-    // the file is read: fill the set 'entries' of Parameter_Entry:
-    NOMAD::Parameter_Entry * pe;
-    std::string              s;
-    int line_number = 0;
+    const std::string & hyperParamFileName = file.getFileName();
     
-    while ( fin.good() && !fin.eof() )
-    {
-        
-        s.clear();
-        
-        getline ( fin , s );
-        line_number++;
-        
-        NOMAD::string_vect_padding ( s );
-        
-        if ( !fin.fail() && !s.empty() )
-        {
-            pe = new NOMAD::Parameter_Entry ( s );
-            pe->set_line(line_number);
-            pe->set_param_file( hyperParamFileName );
-            
-            // First test on NOMAD parameters basic syntax
-            // More test on parameters are done later
-            if ( pe->is_ok() )
-            {
-                entries.insert ( pe ); // pe will be deleted by ~Parameter_Entries()
-            }
-            else
-            {
-                // NOMAD parameters basic syntax is not respected
-                if ( pe->get_name() !="" )
-                {
-                    err = pe->get_name() + " does not respect parameters syntax." ;
-                    throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() , err );
-                }
-                else // Case of a comment (erase silently)
-                    delete pe;
-            }
-        }
-    }
-    // the file is closed:
-    fin.close();
+    std::string err;
+    const HyperParametersFile::Entry * pe;
     
     //
     // Analyze the entries and set hyperparameters
     //
-    int m;
     
     // DATASET:
     // -------
     {
-        pe = entries.find ( "DATASET" );
+        pe = file.find ( "DATASET" );
         if ( pe )
         {
-            if ( !pe->is_unique() )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "DATASET not unique" );
             
-            m = pe->get_nb_values();
-            
-            if ( m == 1 )
-                _dataset =  *pe->get_values().begin();
+            if ( pe->nbValues == 1 )
+                _dataset = file.getValue( *pe , 0 );
             else
             {
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "DATASET must be provided only once." );
             }
-            pe->set_has_been_interpreted();
+            file.setInterpreted( *pe );
         }
         else
             throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , 0 ,
@@ -468,46 +646,70 @@ void HyperParameters::read (const std::string & hyperParamFileName )
     // BB_EXE:
     // -------
     {
-        pe = entries.find ( "BB_EXE" );
+        pe = file.find ( "BB_EXE" );
         if ( pe )
         {
-            if ( !pe->is_unique() )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "BB_EXE not unique" );
             
-            m = pe->get_nb_values();
-            
-            if ( m == 1 )
-                _bbEXE =  *pe->get_values().begin();
+            if ( pe->nbValues == 1 )
+            {
+                _bbEXE = file.getValue( *pe , 0 );
+                _defaultBB = false;
+            }
             else
             {
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "number of BB_EXE (>1)." );
             }
-            pe->set_has_been_interpreted();
+            file.setInterpreted( *pe );
+        }
+    }
+    
+    // BB_TRANSFER: FILE (as Nomad, default) or SHARED_MEMORY (persistent workers of the default blackbox)
+    // -------
+    {
+        pe = file.find ( "BB_TRANSFER" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "BB_TRANSFER not unique" );
+            
+            std::string s = ( pe->nbValues == 1 ) ? file.getValue( *pe , 0 ) : "";
+            NOMAD::toupper( s );
+            if ( s.compare( "SHARED_MEMORY" ) == 0 )
+                _sharedMemoryTransfer = true;
+            else if ( s.compare( "FILE" ) != 0 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "BB_TRANSFER FILE|SHARED_MEMORY" );
+            
+            if ( _sharedMemoryTransfer && file.find( "BB_EXE" ) )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "BB_TRANSFER SHARED_MEMORY requires the default blackbox (no BB_EXE)" );
+            file.setInterpreted( *pe );
         }
     }
     
     // SGTE_EXE:
     // -------
     {
-        pe = entries.find ( "SGTE_EXE" );
+        pe = file.find ( "SGTE_EXE" );
         if ( pe )
         {
-            if ( !pe->is_unique() )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "SGTE_EXE not unique" );
             
-            m = pe->get_nb_values();
-            
-            if ( m == 1 )
-                _sgteEXE =  *pe->get_values().begin();
+            if ( pe->nbValues == 1 )
+                _sgteEXE = file.getValue( *pe , 0 );
             else
             {
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "number of SGTE_EXE (>1)." );
             }
-            pe->set_has_been_interpreted();
+            file.setInterpreted( *pe );
         }
     }
     
@@ -516,16 +718,16 @@ void HyperParameters::read (const std::string & hyperParamFileName )
     // ------------
     {
         int i;
-        pe = entries.find ( "MAX_BB_EVAL" );
+        pe = file.find ( "MAX_BB_EVAL" );
         if ( pe )
         {
-            if ( !pe->is_unique() )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "MAX_BB_EVAL not unique" );
-            if ( pe->get_nb_values() != 1 || !NOMAD::atoi (*(pe->get_values().begin()) , i) )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            if ( pe->nbValues != 1 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i) )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "MAX_BB_EVAL" );
-            pe->set_has_been_interpreted();
+            file.setInterpreted( *pe );
             _maxBbEval = i;
         }
         else
@@ -533,20 +735,38 @@ void HyperParameters::read (const std::string & hyperParamFileName )
                                                         "MAX_BB_EVAL must be provided." );
     }
     
+    // BB_MAX_BLOCK_SIZE
+    // ------------
+    {
+        int i;
+        pe = file.find ( "BB_MAX_BLOCK_SIZE" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "BB_MAX_BLOCK_SIZE not unique" );
+            if ( pe->nbValues != 1 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i) || i < 1 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "BB_MAX_BLOCK_SIZE" );
+            file.setInterpreted( *pe );
+            _bbMaxBlockSize = i;
+        }
+    }
+    
     // HYPER_DISPLAY
     // ------------
     {
         int i;
-        pe = entries.find ( "HYPER_DISPLAY" );
+        pe = file.find ( "HYPER_DISPLAY" );
         if ( pe )
         {
-            if ( !pe->is_unique() )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "HYPER_DISPLAY not unique" );
-            if ( pe->get_nb_values() != 1 || !NOMAD::atoi (*(pe->get_values().begin()) , i) || i < 0 )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            if ( pe->nbValues != 1 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i) || i < 0 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "HYPER_DISPLAY" );
-            pe->set_has_been_interpreted();
+            file.setInterpreted( *pe );
             _hyperDisplay = i;
         }
     }
@@ -555,25 +775,312 @@ void HyperParameters::read (const std::string & hyperParamFileName )
     // ------------
     {
         int i;
-        pe = entries.find ( "LH_ITERATION_SEARCH" );
+        pe = file.find ( "LH_ITERATION_SEARCH" );
         if ( pe )
         {
-            if ( !pe->is_unique() )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
-                                                            "HYPER_DISPLAY not unique" );
-            if ( pe->get_nb_values() != 1 || !NOMAD::atoi (*(pe->get_values().begin()) , i) || i < 0 )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
-                                                            "HYPER_DISPLAY" );
-            pe->set_has_been_interpreted();
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "LH_ITERATION_SEARCH not unique" );
+            if ( pe->nbValues != 1 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i) || i < 0 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "LH_ITERATION_SEARCH" );
+            file.setInterpreted( *pe );
             _lhIterationSearch = i;
         }
     }
     
+    // INITIAL_DESIGN
+    // ------------
+    {
+        int i;
+        pe = file.find ( "INITIAL_DESIGN" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "INITIAL_DESIGN not unique" );
+            if ( pe->nbValues != 1 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i) || i < 0 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "INITIAL_DESIGN" );
+            file.setInterpreted( *pe );
+            _initialDesignSize = i;
+        }
+    }
+    
+    // REPLICATIONS
+    // ------------
+    {
+        int i;
+        pe = file.find ( "REPLICATIONS" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "REPLICATIONS not unique" );
+            if ( pe->nbValues != 1 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i) || i < 1 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "REPLICATIONS" );
+            file.setInterpreted( *pe );
+            _replications = i;
+        }
+    }
+    
+    // MAX_EVAL_TIME seconds [median_factor]: the blackbox is stopped after the time budget (censored evaluation).
+    // With a median factor, the budget is reduced to median_factor times the median time of the completed evaluations.
+    // ------------
+    {
+        pe = file.find ( "MAX_EVAL_TIME" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "MAX_EVAL_TIME not unique" );
+            NOMAD::Double t , f = 0.0;
+            if ( pe->nbValues < 1 || pe->nbValues > 2 || ! t.atof( file.getValue( *pe , 0 ) ) || ! t.is_defined() || t <= 0
+                || ( pe->nbValues == 2 && ( ! f.atof( file.getValue( *pe , 1 ) ) || ! f.is_defined() || f <= 1 ) ) )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "MAX_EVAL_TIME seconds [median_factor > 1]" );
+            file.setInterpreted( *pe );
+            _maxEvalTime = t.value();
+            _evalTimeMedianFactor = f.value();
+        }
+    }
+    
+    // MAX_EPOCHS: maximum number of training epochs given to the default blackbox (HYPERNOMAD_MAX_EPOCHS)
+    // ------------
+    {
+        int i;
+        pe = file.find ( "MAX_EPOCHS" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "MAX_EPOCHS not unique" );
+            if ( pe->nbValues != 1 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i) || i < 1 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "MAX_EPOCHS" );
+            file.setInterpreted( *pe );
+            _maxEpochs = i;
+        }
+    }
+    
+    // NEIGHBORHOOD max_step [DUPLICATE_LAYER] [REMOVE_LAYER] [CHANGE_LAYER]: moves of the extended poll
+    // ------------
+    {
+        pe = file.find ( "NEIGHBORHOOD" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "NEIGHBORHOOD not unique" );
+            int i;
+            if ( pe->nbValues < 1 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i ) || i < 1 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "NEIGHBORHOOD max_step [DUPLICATE_LAYER] [REMOVE_LAYER] [CHANGE_LAYER]" );
+            _neighborhoodOptions.maxStep = i;
+            for ( size_t k = 1 ; k < pe->nbValues ; k++ )
+            {
+                std::string s = file.getValue( *pe , k );
+                NOMAD::toupper( s );
+                if ( s.compare( "DUPLICATE_LAYER" ) == 0 )
+                    _neighborhoodOptions.duplicateLayer = true;
+                else if ( s.compare( "REMOVE_LAYER" ) == 0 )
+                    _neighborhoodOptions.removeLayer = true;
+                else if ( s.compare( "CHANGE_LAYER" ) == 0 )
+                    _neighborhoodOptions.changeLayer = true;
+                else
+                    throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                                "NEIGHBORHOOD max_step [DUPLICATE_LAYER] [REMOVE_LAYER] [CHANGE_LAYER]" );
+            }
+            file.setInterpreted( *pe );
+        }
+    }
+    
+    // WARM_START history_files: points of previous campaigns (possibly on another dataset) ranked before the initial design
+    // A relative path is relative to the hyperparameters file
+    // ------------
+    {
+        pe = file.find ( "WARM_START" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "WARM_START not unique" );
+            if ( pe->nbValues < 1 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "WARM_START history_file [history_file ...]" );
+            for ( size_t k = 0 ; k < pe->nbValues ; k++ )
+            {
+                std::string historyFileName = file.getValue( *pe , k );
+                if ( historyFileName.substr( 0 , 1 ).compare( dirSep ) != 0 )
+                    historyFileName = extractDir( hyperParamFileName ) + historyFileName;
+                if ( ! NOMAD::check_read_file( historyFileName ) )
+                    throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                                "WARM_START: cannot read " + historyFileName );
+                _warmStartFiles.push_back( historyFileName );
+            }
+            file.setInterpreted( *pe );
+        }
+    }
+    
+    // WARM_START_POINTS: number of points of the previous campaigns evaluated with the initial design
+    // ------------
+    {
+        int i;
+        pe = file.find ( "WARM_START_POINTS" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "WARM_START_POINTS not unique" );
+            if ( pe->nbValues != 1 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i) || i < 1 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "WARM_START_POINTS" );
+            if ( ! file.find( "WARM_START" ) )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "WARM_START_POINTS requires WARM_START" );
+            file.setInterpreted( *pe );
+            _warmStartPoints = i;
+        }
+    }
+    
+    // The outputs computed from the network need the blocks of the default schema to decode it
+    auto checkNetworkDecoding = [&]( const HyperParametersFile::Entry & entry , const std::string & keyword )
+    {
+        if ( _searchNameIndex.count( "NUM_CON_LAYERS" ) == 0 || _searchNameIndex.count( "NUM_FC_LAYERS" ) == 0 )
+            throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , entry.line ,
+                                                        keyword + " requires the NUM_CON_LAYERS and NUM_FC_LAYERS blocks of the default schema" );
+    };
+    
+    // SECOND_OBJECTIVE: bi-objective optimization with BiMads
+    // TRAINING_TIME and LATENCY are outputs of the blackbox, PARAMETERS and MEMORY (in MB) are computed from the network
+    // --------------------------------
+    {
+        pe = file.find ( "SECOND_OBJECTIVE" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "SECOND_OBJECTIVE not unique" );
+            if ( pe->nbValues != 1 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "SECOND_OBJECTIVE TRAINING_TIME|LATENCY|PARAMETERS|MEMORY" );
+            if ( _replications > 1 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "SECOND_OBJECTIVE cannot be used with REPLICATIONS" );
+            
+            std::string s = file.getValue( *pe , 0 );
+            NOMAD::toupper( s );
+            if ( s.compare( "TRAINING_TIME" ) == 0 || s.compare( "LATENCY" ) == 0 )
+                _extraOutputs.push_back( { s , 1.0 , NOMAD::OBJ } );
+            else if ( s.compare( "PARAMETERS" ) == 0 || s.compare( "MEMORY" ) == 0 )
+            {
+                checkNetworkDecoding( *pe , "SECOND_OBJECTIVE " + s );
+                _sizeOutputs.push_back( { ( s.compare( "PARAMETERS" ) == 0 ) ? SizeOutputType::PARAMETERS : SizeOutputType::MEMORY , 1.0 , NOMAD::OBJ } );
+            }
+            else
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "SECOND_OBJECTIVE must be TRAINING_TIME, LATENCY, PARAMETERS or MEMORY" );
+            
+            file.setInterpreted( *pe );
+        }
+    }
+    
+    // MAX_PARAMETERS, MAX_MEMORY (in MB): constraints computed from the network
+    // MAX_LATENCY (in ms): constraint on an output of the blackbox
+    // Default type EB
+    // --------------------------------
+    {
+        auto readConstraint = [&]( const std::string & keyword , double & bound , NOMAD::bb_output_type & bbot )
+        {
+            pe = file.find ( keyword );
+            if ( ! pe )
+                return false;
+            
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            keyword + " not unique" );
+            
+            NOMAD::Double d;
+            if ( pe->nbValues < 1 || pe->nbValues > 2 || ! d.atof( file.getValue( *pe , 0 ) ) || ! d.is_defined() || d <= 0 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            keyword + " bound [PB|EB]" );
+            bound = d.value();
+            
+            bbot = NOMAD::EB;
+            if ( pe->nbValues == 2 )
+            {
+                std::string s = file.getValue( *pe , 1 );
+                NOMAD::toupper( s );
+                if ( s.compare( "PB" ) == 0 )
+                    bbot = NOMAD::PB;
+                else if ( s.compare( "EB" ) != 0 )
+                    throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                                keyword + " constraint type must be PB or EB" );
+            }
+            
+            file.setInterpreted( *pe );
+            return true;
+        };
+        
+        double bound;
+        NOMAD::bb_output_type bbot;
+        
+        if ( readConstraint( "MAX_LATENCY" , bound , bbot ) )
+            _extraOutputs.push_back( { "LATENCY" , bound , bbot } );
+        
+        if ( readConstraint( "MAX_PARAMETERS" , bound , bbot ) )
+        {
+            checkNetworkDecoding( *pe , "MAX_PARAMETERS" );
+            _sizeOutputs.push_back( { SizeOutputType::PARAMETERS , bound , bbot } );
+        }
+        
+        if ( readConstraint( "MAX_MEMORY" , bound , bbot ) )
+        {
+            checkNetworkDecoding( *pe , "MAX_MEMORY" );
+            _sizeOutputs.push_back( { SizeOutputType::MEMORY , bound , bbot } );
+        }
+    }
+    
+    // CO_SCHEDULING: small networks (at most max_parameters trainable parameters) with the same batch size
+    // are trained together in one process of the default blackbox, by packs of at most max_networks
+    // --------------------------------
+    {
+        pe = file.find ( "CO_SCHEDULING" );
+        if ( pe )
+        {
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "CO_SCHEDULING not unique" );
+            
+            int i;
+            NOMAD::Double d;
+            if ( pe->nbValues != 2 || !NOMAD::atoi ( file.getValue( *pe , 0 ) , i ) || i < 1 || ! d.atof( file.getValue( *pe , 1 ) ) || ! d.is_defined() || d <= 0 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "CO_SCHEDULING max_networks max_parameters" );
+            
+            if ( file.find( "BB_EXE" ) || _sharedMemoryTransfer )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                            "CO_SCHEDULING requires the default blackbox (no BB_EXE) with BB_TRANSFER FILE" );
+            checkNetworkDecoding( *pe , "CO_SCHEDULING" );
+            
+            _coSchedulingNetworks = i;
+            _coSchedulingMaxParameters = d.value();
+            file.setInterpreted( *pe );
+        }
+    }
+    
+    // Outputs after the objective of the blackbox
+    for ( const auto & e : _extraOutputs )
+        _bbot.push_back( e.bbot );
+    for ( const auto & c : _sizeOutputs )
+        _bbot.push_back( c.bbot );
+    
     // X0:
     // THIS CAN BE SUPERSEDED BY SETTING ON SPECIFIC HYPERPARAM --> see updateBaseAndExpand
     // ----------
     _explicitSetX0 = false;
-    interpretX0( &entries );
+    interpretX0( file );
     
     
     //
@@ -585,7 +1092,7 @@ void HyperParameters::read (const std::string & hyperParamFileName )
     //    {
     //        _fixedVariables.resize ( _X0.size() );
     //
-    //        interpretBoundsAndFixed( "FIXED_VARIABLE" , entries , _fixedVariables );
+    //        interpretBoundsAndFixed( "FIXED_VARIABLE" , file , _fixedVariables );
     //
     //
     //    }
@@ -596,9 +1103,7 @@ void HyperParameters::read (const std::string & hyperParamFileName )
     {
         _explicitSetLowerBounds  = false;
         _lowerBound.resize ( _X0.size() );
-        interpretBoundsAndFixed( "LOWER_BOUND" , entries , _lowerBound );
-        
-        
+        interpretBoundsAndFixed( "LOWER_BOUND" , file , _lowerBound );
     }
     
     // UPPER_BOUND: (same as NOMAD)
@@ -607,7 +1112,7 @@ void HyperParameters::read (const std::string & hyperParamFileName )
     {
         _explicitSetUpperBounds  = false;
         _upperBound.resize ( _X0.size() );
-        interpretBoundsAndFixed( "UPPER_BOUND" , entries , _upperBound );
+        interpretBoundsAndFixed( "UPPER_BOUND" , file , _upperBound );
         
     }
     
@@ -619,7 +1124,7 @@ void HyperParameters::read (const std::string & hyperParamFileName )
         bool alreadyDisplayedMessage = false;
         for ( const auto & searchName : _allSearchNames )
         {
-            pe = entries.find ( searchName );
+            pe = file.find ( searchName );
             if ( pe )
             {
                 if ( _hyperDisplay> 1 && !alreadyDisplayedMessage && ( _explicitSetLowerBounds || _explicitSetUpperBounds || _explicitSetX0 ) )
@@ -631,25 +1136,25 @@ void HyperParameters::read (const std::string & hyperParamFileName )
                     std::cout << "===============================================================" << std::endl << std::endl;
                 }
                     
-                GenericHyperParameter * aHP = getHyperParameter( pe->get_name() );
+                GenericHyperParameter * aHP = getHyperParameter( searchName );
                 
                 if ( aHP == nullptr )
                 {
-                    err = pe->get_name() + " is a registered hyperparameter but no hyperparameter can be obtained.";
+                    err = searchName + " is a registered hyperparameter but no hyperparameter can be obtained.";
                     throw NOMAD::Exception ( __FILE__ , __LINE__ , err );
                 }
                 
-                if ( pe->get_nb_values() > 4 || pe->get_nb_values() < 1 )
-                    throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+                if ( pe->nbValues > 4 || pe->nbValues < 1 )
+                    throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                                 "invalid number of values for "+searchName );
                 
                 
-                std::list<std::string>::const_iterator it = pe->get_values().begin();
-                NOMAD::Double                          v;
+                size_t it = 0;
+                NOMAD::Double v;
                 
                 // X0 per hyperparam
-                if ( !v.atof(*it) )
-                    throw NOMAD::Parameters::Invalid_Parameter (  hyperParamFileName  , pe->get_line() ,
+                if ( !file.getValue( *pe , it , v ) )
+                    throw NOMAD::Parameters::Invalid_Parameter (  hyperParamFileName  , pe->line ,
                                                                 " cannot read value of "+searchName );
                 if ( v.is_defined() )
                     aHP->value = v ;
@@ -658,10 +1163,10 @@ void HyperParameters::read (const std::string & hyperParamFileName )
                 
                 // Lower bound per hyperparam
                 // SUPERSEDED WHEN SETTING LOWER_BOUND
-                if ( it != pe->get_values().end() )
+                if ( it < pe->nbValues )
                 {
-                    if ( !v.atof(*it) ) // Undefined (-) is ok
-                        throw NOMAD::Parameters::Invalid_Parameter (  hyperParamFileName  , pe->get_line() ,
+                    if ( !file.getValue( *pe , it , v ) ) // Undefined (-) is ok
+                        throw NOMAD::Parameters::Invalid_Parameter (  hyperParamFileName  , pe->line ,
                                                                     " cannot read value of "+searchName );
                     // If not defined the default value is used
                     if ( v.is_defined() )
@@ -673,10 +1178,10 @@ void HyperParameters::read (const std::string & hyperParamFileName )
                 
                 // Upper bound per hyperparam
                 // SUPERSEDED WHEN SETTING UPPER_BOUND
-                if ( it != pe->get_values().end() )
+                if ( it < pe->nbValues )
                 {
-                    if ( !v.atof(*it) ) // Undefined (-) is ok
-                        throw NOMAD::Parameters::Invalid_Parameter (  hyperParamFileName  , pe->get_line() ,
+                    if ( !file.getValue( *pe , it , v ) ) // Undefined (-) is ok
+                        throw NOMAD::Parameters::Invalid_Parameter (  hyperParamFileName  , pe->line ,
                                                                     " cannot read value of "+searchName );
                     
                     // If not defined the default value is used
@@ -688,10 +1193,10 @@ void HyperParameters::read (const std::string & hyperParamFileName )
                 
                 // Is it a fixed or variable hyperparam
                 // THE FIXED/VAR FLAG IS NOT SUPERSEDED
-                if ( it != pe->get_values().end() )
+                if ( it < pe->nbValues )
                 {
                     // Accept lower case and upper case
-                    std::string key = *it;
+                    std::string key = file.getValue( *pe , it );
                     NOMAD::toupper( key );
                     
                     if ( key.compare("FIXED") == 0 )
@@ -699,11 +1204,11 @@ void HyperParameters::read (const std::string & hyperParamFileName )
                     else if ( key.compare("VAR") == 0 )
                         aHP->isFixed = false ;
                     else
-                        throw NOMAD::Parameters::Invalid_Parameter (  hyperParamFileName  , pe->get_line() ,
+                        throw NOMAD::Parameters::Invalid_Parameter (  hyperParamFileName  , pe->line ,
                                                                     " cannot read value of "+searchName );
                     ++it;
                 }
-                pe->set_has_been_interpreted();
+                file.setInterpreted( *pe );
                 
                 // This hyperparameter is set by its name. This flag is used when setting the remaining parameters (see below)
                 aHP->settingByName = true;
@@ -714,21 +1219,21 @@ void HyperParameters::read (const std::string & hyperParamFileName )
     // REMAINING_HPS:
     // ------------
     {
-        pe = entries.find ( "REMAINING_HPS" );
+        pe = file.find ( "REMAINING_HPS" );
         if ( pe )
         {
-            if ( !pe->is_unique() )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            if ( !pe->unique )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "REMAINING_HPS not unique" );
-            if ( pe->get_nb_values() != 1 )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            if ( pe->nbValues != 1 )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "REMAINING_HPS FIXED/VAR" );
             
             bool fixed = false;
-            if ( pe->get_values().begin()->compare("FIXED") == 0 )
+            if ( file.valueEquals( *pe , 0 , "FIXED" ) )
                 fixed = true;
-            else if ( pe->get_values().begin()->compare("VAR") != 0 )
-                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() ,
+            else if ( ! file.valueEquals( *pe , 0 , "VAR" ) )
+                throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
                                                             "REMAINING_HPS FIXED/VAR" );
             
             for ( auto & block : _baseHyperParameters )
@@ -762,15 +1267,15 @@ void HyperParameters::read (const std::string & hyperParamFileName )
                     }
                 }
             }
-            pe->set_has_been_interpreted();
+            file.setInterpreted( *pe );
         }
     }
     
-    pe = entries.find_non_interpreted();
+    pe = file.findNonInterpreted();
     if ( pe )
     {
-        err = pe->get_name() + " - unknown";
-        throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->get_line() , err );
+        err = file.getName( *pe ) + " - unknown";
+        throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line , err );
     }
     
 }
@@ -793,28 +1298,31 @@ void HyperParameters::updateAndCheckAfterReading ( void )
     // Complete the line for the blackbox with the dataset name (ex.: python pytorch_bb.py MNIST)
     _bbEXE += " " + _dataset;
     _sgteEXE += " " + _dataset;
+    _bbWorkerEXE += " " + _dataset;
     
 }
 
-void HyperParameters::interpretBoundsAndFixed ( const std::string & paramName , const NOMAD::Parameter_Entries & entries , NOMAD::Point & param )
+void HyperParameters::interpretBoundsAndFixed ( const std::string & paramName , const HyperParametersFile & file , NOMAD::Point & param )
 {
     
     const std::string invalidFormatErr = "Invalid format for " + paramName;
     
-    NOMAD::Parameter_Entry                 * pe = entries.find ( paramName );
+    const HyperParametersFile::Entry * pe = file.find ( paramName );
     if ( !pe )
         return;
     
+    const std::string & paramFile = file.getFileName();
+
     std::string                              err;
-    if ( !pe->is_unique() )
+    if ( !pe->unique )
     {
         err = paramName + " not unique";
-        throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line(), err );
+        throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line, err );
     }
     
     
     
-    std::list<std::string>::const_iterator   it;
+    size_t                                   it;
     int                                      i, j, k;
     NOMAD::Double                            v;
     
@@ -835,67 +1343,61 @@ void HyperParameters::interpretBoundsAndFixed ( const std::string & paramName ,
     
     
     // just one index or *:
-    if ( pe->get_nb_values() == 1 )
+    if ( pe->nbValues == 1 )
     {
         
         if ( paramName.compare("FIXED_VARIABLE") != 0 )
         {
             err = "Cannot set " + paramName +" using a single value or * ";
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line(), err );
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line, err );
         }
         
         // special case for FIXED_VARIABLE without value
         // (the value will be taken from x0, if unique):
-        if ( isdigit ( (*pe->get_values().begin())[0] ) ||
-            *pe->get_values().begin() == "*"               )
+        std::string value = file.getValue( *pe , 0 );
+        if ( isdigit ( value[0] ) || value == "*" )
         {
             
-            if ( !NOMAD::string_to_index_range ( *pe->get_values().begin() ,
-                                                i                         ,
-                                                j                         ,
-                                                & dimension  )              )
-                throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line(), invalidFormatErr );
+            if ( !NOMAD::string_to_index_range ( value       ,
+                                                i           ,
+                                                j           ,
+                                                & dimension  )  )
+                throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line, invalidFormatErr );
             
             for ( k = i ; k <= j ; ++k )
                 param[k] = _X0[k] ;
         }
         else
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line(), invalidFormatErr );
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line, invalidFormatErr );
         
     }
     
     // vector form: all values on one row:
-    else if ( pe->get_nb_values() == dimension + 2 )
+    else if ( pe->nbValues == static_cast<size_t>(dimension) + 2 )
     {
         
-        if ( !pe->is_unique() )
-        {
-            err = paramName + " has been given in vector form with [] or () and is not unique";
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line() , err );
-        }
-        
-        it = pe->get_values().begin();
+        it = 0;
         
-        if ( *it != "[" && *it != "(" )
+        if ( ! file.valueEquals( *pe , it , "[" ) && ! file.valueEquals( *pe , it , "(" ) )
         {
             err = paramName + " in vector form with () or []";
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line() , err );
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line , err );
         }
         
         ++it;
         for ( k = 0 ; k < dimension ; ++k )
         {
-            if ( !v.atof(*it) )
-                throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line(), invalidFormatErr );
+            if ( !file.getValue( *pe , it , v ) )
+                throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line, invalidFormatErr );
             
             ++it;
             param[k] = v;
         }
         
-        if ( *it != "]" && *it != ")" )
+        if ( ! file.valueEquals( *pe , it , "]" ) && ! file.valueEquals( *pe , it , ")" ) )
         {
             err = paramName + " error in vector form with () or []";
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line() , err );
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line , err );
         }
     }
     
@@ -903,80 +1405,109 @@ void HyperParameters::interpretBoundsAndFixed ( const std::string & paramName ,
     else
     {
         
-        if ( pe->get_nb_values() != 2 )
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line(), invalidFormatErr );
+        if ( pe->nbValues != 2 )
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line, invalidFormatErr );
         
-        it = pe->get_values().begin();
-        if ( !NOMAD::string_to_index_range ( *it , i , j , &dimension ) )
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line(), invalidFormatErr );
-        ++it;
-        if ( !v.atof(*it) )
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line(), invalidFormatErr );
+        if ( !NOMAD::string_to_index_range ( file.getValue( *pe , 0 ) , i , j , &dimension ) )
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line, invalidFormatErr );
+        if ( !file.getValue( *pe , 1 , v ) )
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line, invalidFormatErr );
         
         for ( k = j ; k >= i ; --k )
             param[k] =v;
     }
-    pe->set_has_been_interpreted();
+    file.setInterpreted( *pe );
 }
 
 
-void HyperParameters::interpretX0( NOMAD::Parameter_Entries * entries )
+// X0 ( 1 2 3 ) or X0 points_file (one point per line, brackets are optional). X0 can be given several times.
+// The first point is X0, the other points are starting points evaluated with the initial design.
+void HyperParameters::interpretX0( const HyperParametersFile & file )
 {
     
-    std::list<std::string>::const_iterator it;
-    NOMAD::Double                          v;
+    NOMAD::Double v;
     
-    NOMAD::Parameter_Entry * pe ;
+    const std::string & paramFile = file.getFileName();
     
-    pe = entries->find ( "X0" );
+    std::vector<NOMAD::Point> points;
     
-    if ( pe )
+    for ( const HyperParametersFile::Entry * pe = file.find ( "X0" ) ; pe ; pe = file.getNext( *pe ) )
     {
         _explicitSetX0 = true;
         
-        std::vector<NOMAD::Double> tmpX0;
+        // A file of points. A relative path is relative to the hyperparameters file
+        if ( pe->nbValues == 1 )
+        {
+            std::string pointsFileName = file.getValue( *pe , 0 );
+            if ( pointsFileName.substr( 0 , 1 ).compare( dirSep ) != 0 )
+                pointsFileName = extractDir( paramFile ) + pointsFileName;
+            
+            std::ifstream fin ( pointsFileName.c_str() );
+            if ( fin.fail() )
+                throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line ,
+                                                            "Point X0 reading error: cannot read the file " + pointsFileName );
+            std::string line;
+            while ( std::getline( fin , line ) )
+            {
+                std::istringstream iss ( line );
+                std::vector<NOMAD::Double> values;
+                std::string s;
+                while ( iss >> s && s[0] != '#' )
+                {
+                    if ( s == "(" || s == ")" || s == "[" || s == "]" )
+                        continue;
+                    if ( ! v.atof( s ) )
+                        throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line ,
+                                                                    "Point X0 reading error: cannot read values in " + pointsFileName );
+                    values.push_back( v );
+                }
+                if ( values.empty() )
+                    continue;
+                
+                points.push_back( NOMAD::Point( static_cast<int>( values.size() ) ) );
+                for ( size_t i = 0 ; i < values.size() ; i++ )
+                    points.back()[static_cast<int>(i)] = values[i];
+            }
+            if ( points.empty() )
+                throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line ,
+                                                            "Point X0 reading error: no point in " + pointsFileName );
+            file.setInterpreted( *pe );
+            continue;
+        }
         
         // Simpler version of reading NOMAD::Point taken from Nomad
-        it = pe->get_values().begin();
-        
         // Reading in the format X0 ( 1 2 3 4 5 )
-        if ( *it != "(" && *it != "[" )
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line() ,
+        size_t it = 0;
+        if ( ! file.valueEquals( *pe , it , "(" ) && ! file.valueEquals( *pe , it , "[" ) )
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line ,
                                                         "Point X0 reading error: vector form must be within () or []" );
         
-        ++it;
-        while ( it !=pe->get_values().end() && *it != "]" && *it != ")"  )
-        {
-            if ( !v.atof(*it) )
-                throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file(), pe->get_line() ,
-                                                            "Point X0 reading error: cannot read values" );
-            ++it;
-            tmpX0.push_back( v );
-        }
-        
-        if ( *it != "]" && *it != ")" )
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line() ,
+        // Values are between the brackets: the dimension is known before reading the values
+        size_t last = pe->nbValues - 1;
+        if ( last == 0 || ( ! file.valueEquals( *pe , last , "]" ) && ! file.valueEquals( *pe , last , ")" ) ) )
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line ,
                                                         "Point X0 reading error: vector form must be within () or []" );
-        if ( tmpX0.size() == 0 )
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line() ,
+        if ( last == 1 )
+            throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line ,
                                                         "Point X0 reading error: no values provided within [] or () " );
-        pe->set_has_been_interpreted();
-        
-        
-        // Set X0
-        _X0.reset( static_cast<int>(tmpX0.size()) );
-        size_t i = 0;
-        for ( auto v : tmpX0 )
-            _X0[i++] = v;
         
-        
-        pe = pe->get_next();
-        
-        if ( pe )
-            throw NOMAD::Parameters::Invalid_Parameter ( pe->get_param_file() , pe->get_line() ,
-                                                        "Point X0 reading error: multiplie definition" );
+        points.push_back( NOMAD::Point( static_cast<int>( last - 1 ) ) );
+        for ( it = 1 ; it < last ; it++ )
+        {
+            if ( !file.getValue( *pe , it , v ) )
+                throw NOMAD::Parameters::Invalid_Parameter ( paramFile , pe->line ,
+                                                            "Point X0 reading error: cannot read values" );
+            points.back()[static_cast<int>(it - 1)] = v;
+        }
+        file.setInterpreted( *pe );
     }
     
+    if ( points.empty() )
+        return;
+    
+    // Set X0. The other points are projected in the search space after the expansion.
+    _X0 = points[0];
+    _otherX0s.assign( points.begin() + 1 , points.end() );
 }
 
 
@@ -993,20 +1524,29 @@ HyperParameters::HyperParameters ( const std::vector<HyperParametersBlock> & hyp
 void HyperParameters::registerSearchNames()
 {
     _allSearchNames.clear();
+    _searchNameIndex.clear();
     
-    // get search name from base definition of hyperparameters
-    for ( auto & aHyperParameterBlock : _baseHyperParameters )
+    // Register the search names of the base definition of hyperparameters (head and first group of each block)
+    // The index is used to get an hyperparameter from its name without searching the blocks
+    auto registerName = [this]( const std::string & searchName , const SearchNameLocation & location )
     {
-        // Get all search names used in a block and verify that there is no duplicate name
-        std::vector<std::string> blockSearchNames = aHyperParameterBlock.getSearchNames();
-        _allSearchNames.insert(_allSearchNames.end(),blockSearchNames.begin(),blockSearchNames.end());
-    }
+        if ( ! _searchNameIndex.emplace( searchName , location ).second )
+            throw NOMAD::Exception ( __FILE__ , __LINE__ ,"HyperParameters: some hyperparameters in definition have duplicate names (" + searchName + ")." );
+        _allSearchNames.push_back( searchName );
+    };
     
-    // Search duplicates based on the registered search name
-    for ( std::vector<std::string>::iterator it=_allSearchNames.begin() ; it < _allSearchNames.end() ; it++ )
+    for ( size_t i = 0 ; i < _baseHyperParameters.size() ; i++ )
     {
-        if ( std::find ( _allSearchNames.begin(), it , *it ) != it )
-            throw NOMAD::Exception ( __FILE__ , __LINE__ ,"HyperParameters: some hyperparameters in definition have duplicate names." );
+        const HyperParametersBlock & aHyperParameterBlock = _baseHyperParameters[i];
+        
+        registerName( aHyperParameterBlock.headOfBlockHyperParameter.searchName , { i , -1 , 0 } );
+        
+        if ( aHyperParameterBlock.groupsOfAssociatedHyperParameters.size() > 0 )
+        {
+            const std::vector<GenericHyperParameter> & group = aHyperParameterBlock.groupsOfAssociatedHyperParameters[0];
+            for ( size_t j = 0 ; j < group.size() ; j++ )
+                registerName( group[j].searchName , { i , 0 , j } );
+        }
     }
 }
 
@@ -1031,129 +1571,250 @@ void HyperParameters::check( void )
 
 HyperParameters::GenericHyperParameter * HyperParameters::getHyperParameter( const std::string & searchName )
 {
-    
-    if ( std::find ( _allSearchNames.begin(), _allSearchNames.end() , searchName ) == _allSearchNames.end() )
+    auto it = _searchNameIndex.find( searchName );
+    if ( it == _searchNameIndex.end() )
         throw NOMAD::Exception ( __FILE__ , __LINE__ ,"HyperParameters: cannot get an hyperparameters which name is " + searchName );
     
-    GenericHyperParameter * aHP = nullptr;
+    const SearchNameLocation & location = it->second;
+    HyperParametersBlock & aHyperParameterBlock = _baseHyperParameters[location.block];
     
-    // Search base definition based on hyperparameter name
-    for ( auto & aHyperParameterBlock : _baseHyperParameters )
-    {
-        aHP = aHyperParameterBlock.getHyperParameter( searchName );
-        if ( aHP != nullptr && aHP->isDefined() )
-            break;
-    }
-    return aHP;
+    if ( location.groupSlot < 0 )
+        return &aHyperParameterBlock.headOfBlockHyperParameter;
+    
+    return &aHyperParameterBlock.groupsOfAssociatedHyperParameters[location.groupSlot][location.offset];
 }
 
-HyperParameters::GroupsOfAssociatedHyperParameters HyperParameters::createGroupsOfAssociatedParameters(const std::string & blockName)
+// The block structure is compiled from a schema: the default one (see defaultSchema.hpp) or the one given by SEARCH_SPACE_SCHEMA
+void HyperParameters::initBlockStructure ( const HyperParametersFile & hyperParamFile )
 {
-    GroupsOfAssociatedHyperParameters associatedHyperParameters;
-    if ( blockName.compare("Convolutional layers") == 0 )
+    HyperParametersFile schema;
+    
+    // SEARCH_SPACE_SCHEMA:
+    // -------
+    const HyperParametersFile::Entry * pe = hyperParamFile.find ( "SEARCH_SPACE_SCHEMA" );
+    if ( pe )
     {
+        const std::string & hyperParamFileName = hyperParamFile.getFileName();
         
-        GenericHyperParameter hp1={"NUM_OUTPUT_LAYERS","Number of output channels",NOMAD::INTEGER,6,1,1000, ReportValueType::COPY_VALUE};
-        GenericHyperParameter hp2={"KERNELS","Kernel size",NOMAD::INTEGER,5,1,20, ReportValueType::COPY_VALUE};
-        GenericHyperParameter hp3={"STRIDES","Stride",NOMAD::INTEGER,1,1,3, ReportValueType::COPY_VALUE};
-        GenericHyperParameter hp4={"PADDINGS","Padding",NOMAD::INTEGER,0,0,2, ReportValueType::COPY_VALUE};
-        GenericHyperParameter hp5={"POOLING_SIZE","Pooling",NOMAD::INTEGER,2,1,5, ReportValueType::COPY_VALUE};
-        associatedHyperParameters={{hp1,hp2,hp3,hp4,hp5}};
-    }
-    else if ( blockName.compare("Full layers") == 0 )
-    {
-        GenericHyperParameter hp6={"SIZE_FC_LAYER","Size of a full layer",NOMAD::INTEGER,128,1,1000, ReportValueType::COPY_VALUE };
-        associatedHyperParameters={{hp6}};
-    }
-    else if ( blockName.compare("Optimizer") == 0 )
-    {
-        GenericHyperParameter hp7={"OPT_PARAM_1","Learning rate",NOMAD::CONTINUOUS,0.1,0,1, ReportValueType::COPY_INITIAL_VALUE};
-        GenericHyperParameter hp8={"OPT_PARAM_2","Momentum",NOMAD::CONTINUOUS,0.9,0,1, ReportValueType::COPY_INITIAL_VALUE};
-        GenericHyperParameter hp9={"OPT_PARAM_3","Weight decay",NOMAD::CONTINUOUS,0.0005,0,1, ReportValueType::COPY_INITIAL_VALUE};
-        GenericHyperParameter hp10={"OPT_PARAM_4","Dampening",NOMAD::CONTINUOUS,0,0,1, ReportValueType::COPY_INITIAL_VALUE};
-        associatedHyperParameters={{hp7,hp8,hp9,hp10}};
+        if ( !pe->unique )
+            throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                        "SEARCH_SPACE_SCHEMA not unique" );
+        if ( pe->nbValues != 1 )
+            throw NOMAD::Parameters::Invalid_Parameter ( hyperParamFileName , pe->line ,
+                                                        "SEARCH_SPACE_SCHEMA schema_file" );
+        
+        // A relative path is relative to the hyperparameters file
+        std::string schemaFileName = hyperParamFile.getValue( *pe , 0 );
+        if ( schemaFileName.substr( 0 , 1 ).compare( dirSep ) != 0 )
+            schemaFileName = extractDir( hyperParamFileName ) + schemaFileName;
+        
+        schema.read( schemaFileName );
+        hyperParamFile.setInterpreted( *pe );
     }
     else
-        throw NOMAD::Exception ( __FILE__ , __LINE__ ,"HyperParameters: cannot create Groups of associated parameters of name " + blockName );
-    return associatedHyperParameters;
-}
-
-void HyperParameters::initBlockStructureToDefault ( void )
-{
-    //
-    // The block structure (with some default values) for Pytorch
-    //
+        schema.parse( defaultSchema , "default schema" );
     
-    // Pytorch dataset available by default
-    _registeredDataset = { "MINIMNIST", "MNIST","Fashion-MNIST","EMNIST","KMNIST","CIFAR10","CIFAR100","STL10","SVHN"};
+    compileSchema( schema );
     
     // dataset name and the corresponding number of classes have no default
     _dataset = "";
     
-    // FIRST HYPER PARAMETERS BLOCK (Convolutionnal layers)
-    GenericHyperParameter headOfBlock1={"NUM_CON_LAYERS","Number of convolutionnal layers",NOMAD::CATEGORICAL,1,0,100};
-    
-    // Call static function to create the associated parameters
-    GroupsOfAssociatedHyperParameters associatedHyperParameters1= createGroupsOfAssociatedParameters("Convolutional layers");
-    
-    HyperParametersBlock block1={"Convolutionnal layers",headOfBlock1, NeighborType::PLUS_ONE_MINUS_ONE_RIGHT, AssociatedHyperParametersType::MULTIPLE_TIMES, associatedHyperParameters1};
-    
-    
-    // SECOND CATEGORICAL BLOCK (Full layers)
-    GenericHyperParameter headOfBlock2={"NUM_FC_LAYERS","Number of modifyable full layers",NOMAD::CATEGORICAL,2,0,500};
-    
-    // Call static function to create the associated parameters
-    GroupsOfAssociatedHyperParameters associatedHyperParameters2 = createGroupsOfAssociatedParameters("Full layers");
-    
-    HyperParametersBlock block2={"Full layers",headOfBlock2, NeighborType::PLUS_ONE_MINUS_ONE_LEFT, AssociatedHyperParametersType::MULTIPLE_TIMES, associatedHyperParameters2};
-    
-    // THIRD BLOCK (single regular parameter: batch size)
-    GenericHyperParameter headOfBlock3={"BATCH_SIZE","Batch size",NOMAD::INTEGER,128,1,400};
-    HyperParametersBlock block3={"Batch size",headOfBlock3,NeighborType::NONE,AssociatedHyperParametersType::ZERO_TIME,};
-    
-    // FOURTH CATEGORICAL BLOCK (Optimizer select)
-    GenericHyperParameter headOfBlock4={"OPTIMIZER_CHOICE","Choice of optimizer",NOMAD::CATEGORICAL,3,1,4};
-    
-    // Call static function to create the associated parameters
-    GroupsOfAssociatedHyperParameters associatedHyperParameters4 = createGroupsOfAssociatedParameters("Optimizer");
+    // BB Output type
+    _bbot={ NOMAD::OBJ };
     
-    HyperParametersBlock block4={"Optimizer",headOfBlock4, NeighborType::LOOP_PLUS_ONE_RIGHT, AssociatedHyperParametersType::ONE_TIME, associatedHyperParameters4};
+    // Max BB eval
+    _maxBbEval = 100;
     
-    // FITH BLOCK (single regular parameter: Dropout rate)
-    GenericHyperParameter headOfBlock5={"DROPOUT_RATE","Dropout rate",NOMAD::CONTINUOUS,0.2,0,0.95};
-    HyperParametersBlock block5={"Dropout rate",headOfBlock5, NeighborType::NONE, AssociatedHyperParametersType::ZERO_TIME,};
+    // Points evaluated one at a time
+    _bbMaxBlockSize = 1;
+}
+
+// Create the base blocks of hyperparameters from the schema entries (taken in the order of the schema)
+void HyperParameters::compileSchema ( const HyperParametersFile & schema )
+{
+    const std::string & schemaName = schema.getFileName();
     
-    // SIXTH BLOCK (single regular parameter: Activation function)
-    GenericHyperParameter headOfBlock6={"ACTIVATION_FUNCTION","Activation function",NOMAD::INTEGER,1,1,3};
-    HyperParametersBlock block6={"Activation function",headOfBlock6, NeighborType::NONE, AssociatedHyperParametersType::ZERO_TIME,};
+    _baseHyperParameters.clear();
+    _registeredDataset.clear();
+    _X0.reset();
     
-    // ALL BASE HYPER PARAMETERS (NOT EXPANDED)
-    _baseHyperParameters = {block1,block2,block3,block4,block5,block6};
+    // The group of associated hyperparameters of the current block
+    std::vector<GenericHyperParameter> group;
+    int blockLine = 0;
     
+    // Check the current block and put the group of associated hyperparameters into it
+    auto closeBlock = [&]()
+    {
+        if ( _baseHyperParameters.empty() )
+            return;
+        
+        HyperParametersBlock & block = _baseHyperParameters.back();
+        
+        if ( ! block.headOfBlockHyperParameter.isDefined() )
+            throw NOMAD::Parameters::Invalid_Parameter ( schemaName , blockLine ,
+                                                        "no HEAD for block " + block.name );
+        
+        if ( block.associatedParametersType == AssociatedHyperParametersType::ZERO_TIME && ! group.empty() )
+            throw NOMAD::Parameters::Invalid_Parameter ( schemaName , blockLine ,
+                                                        "block " + block.name + " is ZERO_TIME but has ASSOCIATED hyperparameters" );
+        
+        if ( block.associatedParametersType != AssociatedHyperParametersType::ZERO_TIME && group.empty() )
+            throw NOMAD::Parameters::Invalid_Parameter ( schemaName , blockLine ,
+                                                        "block " + block.name + " requires ASSOCIATED hyperparameters" );
+        
+        if ( ! group.empty() )
+        {
+            block.groupsOfAssociatedHyperParameters = { group };
+            block.defaultGroupOfAssociatedHyperParameters = std::make_shared<const std::vector<GenericHyperParameter>>( group );
+        }
+        group.clear();
+    };
     
-    // BB Output type
-    _bbot={ NOMAD::OBJ };
+    // HEAD and ASSOCIATED: SEARCH_NAME "full name" TYPE value lb ub
+    auto readHyperParameter = [&]( const HyperParametersFile::Entry & e , const std::string & keyword , size_t nbValues )
+    {
+        if ( e.nbValues != nbValues )
+            throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line ,
+                                                        "invalid number of values for " + keyword );
+        
+        GenericHyperParameter hp;
+        hp.searchName = schema.getValue( e , 0 );
+        NOMAD::toupper( hp.searchName );
+        hp.fullName = schema.getValue( e , 1 );
+        
+        if ( schema.valueEquals( e , 2 , "CATEGORICAL" ) )
+            hp.type = NOMAD::CATEGORICAL;
+        else if ( schema.valueEquals( e , 2 , "INTEGER" ) )
+            hp.type = NOMAD::INTEGER;
+        else if ( schema.valueEquals( e , 2 , "CONTINUOUS" ) )
+            hp.type = NOMAD::CONTINUOUS;
+        else if ( schema.valueEquals( e , 2 , "BINARY" ) )
+            hp.type = NOMAD::BINARY;
+        else
+            throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line ,
+                                                        "invalid type for " + hp.searchName );
+        
+        // The default value is required, the bounds can be undefined (-)
+        if ( ! schema.getValue( e , 3 , hp.value ) || ! hp.value.is_defined()
+            || ! schema.getValue( e , 4 , hp.lowerBoundValue )
+            || ! schema.getValue( e , 5 , hp.upperBoundValue ) )
+            throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line ,
+                                                        "invalid values for " + hp.searchName );
+        return hp;
+    };
     
-    // Max BB eval
-    _maxBbEval = 100;
+    for ( const auto & e : schema.getEntries() )
+    {
+        const std::string keyword = schema.getName( e );
+        
+        if ( keyword.compare( "DATASETS" ) == 0 )
+        {
+            for ( size_t i = 0 ; i < e.nbValues ; i++ )
+                _registeredDataset.push_back( schema.getValue( e , i ) );
+        }
+        else if ( keyword.compare( "BLOCK" ) == 0 )
+        {
+            closeBlock();
+            
+            if ( e.nbValues != 3 )
+                throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line ,
+                                                            "BLOCK \"name\" NEIGHBOR_TYPE ASSOCIATED_TYPE" );
+            
+            HyperParametersBlock block;
+            block.name = schema.getValue( e , 0 );
+            
+            if ( schema.valueEquals( e , 1 , "NONE" ) )
+                block.neighborType = NeighborType::NONE;
+            else if ( schema.valueEquals( e , 1 , "PLUS_ONE_MINUS_ONE_RIGHT" ) )
+                block.neighborType = NeighborType::PLUS_ONE_MINUS_ONE_RIGHT;
+            else if ( schema.valueEquals( e , 1 , "PLUS_ONE_MINUS_ONE_LEFT" ) )
+                block.neighborType = NeighborType::PLUS_ONE_MINUS_ONE_LEFT;
+            else if ( schema.valueEquals( e , 1 , "LOOP_PLUS_ONE_RIGHT" ) )
+                block.neighborType = NeighborType::LOOP_PLUS_ONE_RIGHT;
+            else if ( schema.valueEquals( e , 1 , "LOOP_PLUS_ONE_LEFT" ) )
+                block.neighborType = NeighborType::LOOP_PLUS_ONE_LEFT;
+            else if ( schema.valueEquals( e , 1 , "LOOP_MINUS_ONE_RIGHT" ) )
+                block.neighborType = NeighborType::LOOP_MINUS_ONE_RIGHT;
+            else if ( schema.valueEquals( e , 1 , "LOOP_MINUS_ONE_LEFT" ) )
+                block.neighborType = NeighborType::LOOP_MINUS_ONE_LEFT;
+            else
+                throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line ,
+                                                            "invalid neighbor type for block " + block.name );
+            
+            if ( schema.valueEquals( e , 2 , "ZERO_TIME" ) )
+                block.associatedParametersType = AssociatedHyperParametersType::ZERO_TIME;
+            else if ( schema.valueEquals( e , 2 , "ONE_TIME" ) )
+                block.associatedParametersType = AssociatedHyperParametersType::ONE_TIME;
+            else if ( schema.valueEquals( e , 2 , "MULTIPLE_TIMES" ) )
+                block.associatedParametersType = AssociatedHyperParametersType::MULTIPLE_TIMES;
+            else
+                throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line ,
+                                                            "invalid associated type for block " + block.name );
+            
+            _baseHyperParameters.push_back( block );
+            blockLine = e.line;
+        }
+        else if ( keyword.compare( "HEAD" ) == 0 )
+        {
+            if ( _baseHyperParameters.empty() )
+                throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line , "HEAD must follow a BLOCK" );
+            
+            HyperParametersBlock & block = _baseHyperParameters.back();
+            if ( block.headOfBlockHyperParameter.isDefined() )
+                throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line , "HEAD already given for block " + block.name );
+            
+            block.headOfBlockHyperParameter = readHyperParameter( e , keyword , 6 );
+        }
+        else if ( keyword.compare( "ASSOCIATED" ) == 0 )
+        {
+            if ( _baseHyperParameters.empty() || ! _baseHyperParameters.back().headOfBlockHyperParameter.isDefined() )
+                throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line , "ASSOCIATED must follow the HEAD of a BLOCK" );
+            
+            GenericHyperParameter hp = readHyperParameter( e , keyword , 7 );
+            
+            if ( schema.valueEquals( e , 6 , "NO_REPORT" ) )
+                hp.reportValueType = ReportValueType::NO_REPORT;
+            else if ( schema.valueEquals( e , 6 , "COPY_VALUE" ) )
+                hp.reportValueType = ReportValueType::COPY_VALUE;
+            else if ( schema.valueEquals( e , 6 , "COPY_INITIAL_VALUE" ) )
+                hp.reportValueType = ReportValueType::COPY_INITIAL_VALUE;
+            else
+                throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line ,
+                                                            "invalid report policy for " + hp.searchName );
+            group.push_back( hp );
+        }
+        else if ( keyword.compare( "X0" ) == 0 )
+        {
+            // Values with or without parenthesis
+            std::vector<NOMAD::Double> x0;
+            for ( size_t i = 0 ; i < e.nbValues ; i++ )
+            {
+                if ( schema.valueEquals( e , i , "(" ) || schema.valueEquals( e , i , ")" ) )
+                    continue;
+                
+                NOMAD::Double v;
+                if ( ! schema.getValue( e , i , v ) || ! v.is_defined() )
+                    throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line , "invalid X0" );
+                x0.push_back( v );
+            }
+            _X0.reset( static_cast<int>( x0.size() ) );
+            for ( size_t i = 0 ; i < x0.size() ; i++ )
+                _X0[static_cast<int>(i)] = x0[i];
+        }
+        else
+            throw NOMAD::Parameters::Invalid_Parameter ( schemaName , e.line , keyword + " - unknown" );
+    }
+    closeBlock();
     
-    // Default X0 compatible with the default structure (default values in structure are changed)
-    const double x0[]={2 , // Number of convolutionnal layers
-        6 , 5 , 1 , 0 , 1 ,
-        16 , 5 , 1 , 0 , 1 ,
-        2 , // Number of adjsutable full layers
-        128,
-        84 ,
-        128 ,  // Batch size
-        3,  0.1 ,0.9 , 0.0005,  0 , // Choice of optimizer + optimizer setting
-        0.2, // Dropout rate
-        1 // Activation function
-    };
+    if ( _baseHyperParameters.empty() )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ ,"HyperParameters: no block of hyperparameters in " + schemaName );
     
-    size_t dim_x0 = sizeof(x0) / sizeof(double);
-    _X0.reset ( static_cast<int>(dim_x0) );
-    for ( int i=0 ; i < dim_x0 ; i++ )
-        _X0[i]=x0[i];
+    // Without X0 in the schema, the default X0 is given by the default values of the blocks
+    if ( _X0.size() == 0 )
+    {
+        expand();
+        _X0 = getValues( ValueType::CURRENT_VALUE );
+    }
 }
 
 
@@ -1219,7 +1880,7 @@ void HyperParameters::HyperParametersBlock::expandAssociatedParameters()
 }
 
 // Get an updated group of associated hyperparameters
-std::vector<HyperParameters::GenericHyperParameter> HyperParameters::HyperParametersBlock::updateAssociatedParameters ( std::vector<HyperParameters::GenericHyperParameter> & fromGroup ) const
+std::vector<HyperParameters::GenericHyperParameter> HyperParameters::HyperParametersBlock::updateAssociatedParameters ( const std::vector<HyperParameters::GenericHyperParameter> & fromGroup ) const
 {
 
     if ( fromGroup.empty() )
@@ -1244,6 +1905,16 @@ std::vector<HyperParameters::GenericHyperParameter> HyperParameters::HyperParame
 }
 
 
+const std::vector<HyperParameters::GenericHyperParameter> & HyperParameters::HyperParametersBlock::getDefaultGroupOfAssociatedParameters ( ) const
+{
+    if ( ! defaultGroupOfAssociatedHyperParameters )
+    {
+        std::string err = "No default group of associated hyperparameters in block " + name;
+        throw NOMAD::Exception ( __FILE__ , __LINE__ ,err);
+    }
+    return *defaultGroupOfAssociatedHyperParameters;
+}
+
 void HyperParameters::HyperParametersBlock::expandAndUpdateAssociatedParametersWithConstraints ( void )
 {
     if ( neighborType == NeighborType::NONE )
@@ -1274,11 +1945,8 @@ void HyperParameters::HyperParametersBlock::expandAndUpdateAssociatedParametersW
                 std::vector<GenericHyperParameter> tmpAssociatedHyperParameters;
                 if ( groupsOfAssociatedHyperParameters.size() > 0 )
                     tmpAssociatedHyperParameters = updateAssociatedParameters ( groupsOfAssociatedHyperParameters.back() );
-                else  // No Groups are available, a default one must be created
-                {
-                    GroupsOfAssociatedHyperParameters a = createGroupsOfAssociatedParameters(name);
-                    tmpAssociatedHyperParameters = updateAssociatedParameters ( a[0] );
-                }
+                else  // No Groups are available, the default one of the schema is used
+                    tmpAssociatedHyperParameters = updateAssociatedParameters ( getDefaultGroupOfAssociatedParameters() );
                 
                 groupsOfAssociatedHyperParameters.push_back( tmpAssociatedHyperParameters ) ;
             }
@@ -1293,11 +1961,8 @@ void HyperParameters::HyperParametersBlock::expandAndUpdateAssociatedParametersW
                 std::vector<GenericHyperParameter> tmpAssociatedHyperParameters;
                 if ( groupsOfAssociatedHyperParameters.size() > 0 )
                     tmpAssociatedHyperParameters = updateAssociatedParameters ( groupsOfAssociatedHyperParameters[0] );
-                else  // No Groups are available, a default one must be created
-                {
-                    GroupsOfAssociatedHyperParameters a = createGroupsOfAssociatedParameters(name);
-                    tmpAssociatedHyperParameters = updateAssociatedParameters ( a[0] );
-                }
+                else  // No Groups are available, the default one of the schema is used
+                    tmpAssociatedHyperParameters = updateAssociatedParameters ( getDefaultGroupOfAssociatedParameters() );
                 groupsOfAssociatedHyperParameters.insert( groupsOfAssociatedHyperParameters.begin() , tmpAssociatedHyperParameters ) ;
             }
         }
@@ -1356,13 +2021,13 @@ size_t HyperParameters::HyperParametersBlock::getDimension ( ) const
     if ( headOfBlockHyperParameter.isDefined() )
         s++;
     
-    for ( auto group : groupsOfAssociatedHyperParameters )
+    for ( const auto & group : groupsOfAssociatedHyperParameters )
         s += group.size();
     
     return s;
 }
 
-void HyperParameters::HyperParametersBlock::updateAssociatedParameters( NOMAD::Point & x , NOMAD::Point & lb , NOMAD::Point & ub )
+void HyperParameters::HyperParametersBlock::updateAssociatedParameters( PointReader & x , PointReader & lb , PointReader & ub )
 {
     
     // update associated parameters from x
@@ -1370,29 +2035,19 @@ void HyperParameters::HyperParametersBlock::updateAssociatedParameters( NOMAD::P
     {
         for ( auto & aHP : aGroupAHP )
         {
-            if ( x.is_defined() )
-            {
-                // Update the value
-                aHP.value = x[0];
-                // Trim x from the used value
-                trimLeft( x );
-            }
+            // Update the value and move to the next one
+            if ( x.isDefined() )
+                aHP.value = x.next();
             
             // When LOWER_BOUND is used it supersedes other ways of setting bounds (default or by name of hyperparameter)
-            if ( lb.is_defined() )
-            {
-                aHP.lowerBoundValue = lb[0];
-                trimLeft( lb );
-            }
+            if ( lb.isDefined() )
+                aHP.lowerBoundValue = lb.next();
+            
             // Idem UPPER_BOUND
-            if ( ub.is_defined() )
-            {
-                aHP.upperBoundValue = ub[0];
-                trimLeft( ub );
-            }
+            if ( ub.isDefined() )
+                aHP.upperBoundValue = ub.next();
         }
     }
-    // std::cout << x << std::endl;
     
 }
 
@@ -1460,9 +2115,9 @@ std::vector<size_t> HyperParameters::HyperParametersBlock:: getIndexFixedParams(
     if ( headOfBlockHyperParameter.isFixed )
         indices.push_back( current_index );
     current_index++;
-    for ( auto groupAHP : groupsOfAssociatedHyperParameters )
+    for ( const auto & groupAHP : groupsOfAssociatedHyperParameters )
     {
-        for ( auto aHP : groupAHP )
+        for ( const auto & aHP : groupAHP )
         {
             if ( aHP.isFixed )
                 indices.push_back( current_index );
@@ -1479,7 +2134,7 @@ const HyperParameters::GenericHyperParameter & HyperParameters::HyperParametersB
     
     // We suppose that the groups may have a different size. So we simply go through all groups until reaching the targetd index
     size_t i = 1 ;  // The first hyperparameter of the group has index=1 (0 is for head)
-    for ( auto groupAHP : groupsOfAssociatedHyperParameters )
+    for ( const auto & groupAHP : groupsOfAssociatedHyperParameters )
     {
         for ( const auto & aHP : groupAHP )
         {
@@ -1496,9 +2151,9 @@ const HyperParameters::GenericHyperParameter & HyperParameters::HyperParametersB
 std::vector<NOMAD::bb_input_type> HyperParameters::HyperParametersBlock::getAssociatedTypes ( ) const
 {
     std::vector<NOMAD::bb_input_type> bbi;
-    for ( auto groupAHP : groupsOfAssociatedHyperParameters )
+    for ( const auto & groupAHP : groupsOfAssociatedHyperParameters )
     {
-        for ( auto aHP : groupAHP )
+        for ( const auto & aHP : groupAHP )
             bbi.push_back( aHP.type );
     }
     return bbi;
@@ -1507,9 +2162,9 @@ std::vector<NOMAD::bb_input_type> HyperParameters::HyperParametersBlock::getAsso
 std::vector<NOMAD::Double> HyperParameters::HyperParametersBlock::getAssociatedValues ( ValueType t ) const
 {
     std::vector<NOMAD::Double> values;
-    for ( auto groupAHP : groupsOfAssociatedHyperParameters )
+    for ( const auto & groupAHP : groupsOfAssociatedHyperParameters )
     {
-        for ( auto aHP : groupAHP )
+        for ( const auto & aHP : groupAHP )
         {
             if ( t == ValueType::CURRENT_VALUE )
                 values.push_back( aHP.value );
@@ -1578,7 +2233,7 @@ std::vector<NOMAD::Double> HyperParameters::HyperParametersBlock::getValues( Val
 }
 
 
-std::vector<HyperParameters::HyperParametersBlock> HyperParameters::HyperParametersBlock::getNeighboorsOfBlock( ) const
+std::vector<HyperParameters::HyperParametersBlock> HyperParameters::HyperParametersBlock::getNeighboorsOfBlock( const NeighborhoodOptions & options ) const
 {
     std::vector<HyperParametersBlock> neighboorsOfBlock;
     
@@ -1602,21 +2257,102 @@ std::vector<HyperParameters::HyperParametersBlock> HyperParameters::HyperParamet
     // Perform a partial reduction (if not zero_time)
     newBlockMinusOne.reduceAssociatedParametersWithConstraints();
     
-    // Add plus one neighboor
+    // Add plus k and minus k neighboors (k = 1, ..., maxStep)
     if ( neighborType == NeighborType::PLUS_ONE_MINUS_ONE_RIGHT || neighborType == NeighborType::PLUS_ONE_MINUS_ONE_LEFT )
     {
-        // Add PlusOne only if not on upper bound
-        if (  ! headOfBlockHyperParameter.upperBoundValue.is_defined() || ( headOfBlockHyperParameter.upperBoundValue.is_defined() && headOfBlockHyperParameter.value < headOfBlockHyperParameter.upperBoundValue ) )
+        const NOMAD::Double & value = headOfBlockHyperParameter.value;
+        const NOMAD::Double & lowerBound = headOfBlockHyperParameter.lowerBoundValue;
+        const NOMAD::Double & upperBound = headOfBlockHyperParameter.upperBoundValue;
+        
+        for ( size_t k = 1 ; k <= std::max<size_t>( options.maxStep , 1 ) ; k++ )
         {
-            // Add the new expanded block to the neighboors
-            neighboorsOfBlock.push_back( newBlockPlusOne );
+            const double step = static_cast<double>( k );
+            
+            // Add PlusK only if not above the upper bound
+            if ( ! upperBound.is_defined() || value + step <= upperBound )
+            {
+                if ( k == 1 )
+                    neighboorsOfBlock.push_back( newBlockPlusOne );
+                else
+                {
+                    HyperParametersBlock newBlockPlusK (*this);
+                    newBlockPlusK.headOfBlockHyperParameter.value += step;
+                    newBlockPlusK.expandAndUpdateAssociatedParametersWithConstraints();
+                    neighboorsOfBlock.push_back( newBlockPlusK );
+                }
+            }
+            
+            // Add MinusK only if not below the lower bound
+            if ( ! lowerBound.is_defined() || value - step >= lowerBound )
+            {
+                if ( k == 1 )
+                    neighboorsOfBlock.push_back( newBlockMinusOne );
+                else
+                {
+                    HyperParametersBlock newBlockMinusK (*this);
+                    newBlockMinusK.headOfBlockHyperParameter.value -= step;
+                    newBlockMinusK.reduceAssociatedParametersWithConstraints();
+                    neighboorsOfBlock.push_back( newBlockMinusK );
+                }
+            }
         }
         
-        // Add MinusOne only if not on lower bound
-        if (  ! headOfBlockHyperParameter.lowerBoundValue.is_defined() || ( headOfBlockHyperParameter.lowerBoundValue.is_defined() && headOfBlockHyperParameter.value > headOfBlockHyperParameter.lowerBoundValue ) )
+        // Moves of a single layer. The layer at the end where +1 adds and -1 removes a layer is skipped (same neighboor)
+        if ( associatedParametersType == AssociatedHyperParametersType::MULTIPLE_TIMES )
         {
-            // Add the new reduced block to the neighboors
-            neighboorsOfBlock.push_back( newBlockMinusOne );
+            const size_t nbGroups = groupsOfAssociatedHyperParameters.size();
+            const bool right = ( neighborType == NeighborType::PLUS_ONE_MINUS_ONE_RIGHT );
+            
+            // Moves on identical layers give the same neighboor: it is added once
+            auto addLayerMove = [&]( const HyperParametersBlock & newBlock )
+            {
+                const std::vector<NOMAD::Double> values = newBlock.getValues( ValueType::CURRENT_VALUE );
+                for ( const auto & n : neighboorsOfBlock )
+                {
+                    if ( n.getValues( ValueType::CURRENT_VALUE ) == values )
+                        return;
+                }
+                neighboorsOfBlock.push_back( newBlock );
+            };
+            
+            for ( size_t g = 0 ; g < nbGroups ; g++ )
+            {
+                const bool atEnd = ( right ) ? ( g + 1 == nbGroups ) : ( g == 0 );
+                
+                if ( options.duplicateLayer && ! atEnd && ( ! upperBound.is_defined() || value + 1.0 <= upperBound ) )
+                {
+                    HyperParametersBlock newBlock (*this);
+                    newBlock.headOfBlockHyperParameter.value ++;
+                    newBlock.groupsOfAssociatedHyperParameters.insert( newBlock.groupsOfAssociatedHyperParameters.begin() + g , groupsOfAssociatedHyperParameters[g] );
+                    addLayerMove( newBlock );
+                }
+                
+                if ( options.removeLayer && ! atEnd && ( ! lowerBound.is_defined() || value - 1.0 >= lowerBound ) )
+                {
+                    HyperParametersBlock newBlock (*this);
+                    newBlock.headOfBlockHyperParameter.value --;
+                    newBlock.groupsOfAssociatedHyperParameters.erase( newBlock.groupsOfAssociatedHyperParameters.begin() + g );
+                    addLayerMove( newBlock );
+                }
+                
+                // The fixed hyperparameters of the layer keep their values
+                if ( options.changeLayer && g > 0 )
+                {
+                    HyperParametersBlock newBlock (*this);
+                    std::vector<GenericHyperParameter> & group = newBlock.groupsOfAssociatedHyperParameters[g];
+                    const std::vector<GenericHyperParameter> & previous = groupsOfAssociatedHyperParameters[g-1];
+                    bool changed = false;
+                    for ( size_t j = 0 ; j < group.size() && j < previous.size() ; j++ )
+                    {
+                        if ( group[j].isFixed || group[j].value == previous[j].value )
+                            continue;
+                        group[j].value = previous[j].value;
+                        changed = true;
+                    }
+                    if ( changed )
+                        addLayerMove( newBlock );
+                }
+            }
         }
     }
     
@@ -1666,33 +2402,3 @@ std::vector<HyperParameters::HyperParametersBlock> HyperParameters::HyperParamet
 }
 
 
-std::vector<std::string> HyperParameters::HyperParametersBlock::getSearchNames() const
-{
-    
-    std::vector<std::string> searchNames;
-    
-    searchNames.push_back( headOfBlockHyperParameter.searchName );
-    
-    if ( groupsOfAssociatedHyperParameters.size() > 0 )
-    {
-        for ( const auto & aAP : groupsOfAssociatedHyperParameters[0] )
-            searchNames.push_back( aAP.searchName );
-    }
-    return searchNames;
-}
-
-HyperParameters::GenericHyperParameter * HyperParameters::HyperParametersBlock::getHyperParameter( const std::string & searchName )
-{
-    if ( headOfBlockHyperParameter.searchName.compare(searchName) == 0 )
-        return &headOfBlockHyperParameter;
-    
-    if ( groupsOfAssociatedHyperParameters.size() > 0 )
-    {
-        for ( auto & aAP : groupsOfAssociatedHyperParameters[0] )
-            if ( aAP.searchName.compare(searchName) == 0 )
-                return &aAP;
-    }
-    return nullptr;
-}
-
-
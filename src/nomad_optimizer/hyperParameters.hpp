@@ -30,12 +30,72 @@
 
 #include "nomad.hpp"
 #include "fileutils.hpp"
+#include "hyperParametersFile.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <unordered_map>
 
 const std::string UndefinedStr="Undefined";
 
 enum class ValueType { LOWER_BOUND ,CURRENT_VALUE , UPPER_BOUND , INITIAL_VALUE , FIXED_VARIABLE };
 
 class HyperParameters {
+public:
+    
+    // Layout of a block used to decode a point without the blocks of hyperparameters.
+    // The number of groups is the head value (multipleGroups), 1 or 0 (groupSize is 0).
+    struct BlockLayout
+    {
+        std::string name;
+        bool multipleGroups;
+        size_t groupSize;
+        
+        // Search names of the head and of the associated hyperparameters of a group
+        std::string headSearchName;
+        std::vector<std::string> searchNames;
+        
+        NOMAD::Double headLowerBound;
+        NOMAD::Double headUpperBound;
+        
+        // Bounds of the associated hyperparameters of a group
+        std::vector<NOMAD::Double> lowerBounds;
+        std::vector<NOMAD::Double> upperBounds;
+    };
+    
+    // Moves of the extended poll on the head of blocks with a neighbor type PLUS_ONE_MINUS_ONE (NEIGHBORHOOD keyword).
+    // The layer moves apply to the groups of associated hyperparameters (the layers) of a block with multiple groups.
+    struct NeighborhoodOptions
+    {
+        size_t maxStep = 1;           // Head value changed by +-1, ..., +-maxStep
+        bool duplicateLayer = false;  // A layer is copied next to itself
+        bool removeLayer = false;     // A layer is removed (not the one removed by -1)
+        bool changeLayer = false;     // A layer takes the values of the previous layer
+    };
+    
+    enum class SizeOutputType { PARAMETERS , MEMORY };
+    
+    // Size of the network computed without the blackbox: objective (SECOND_OBJECTIVE, the bound is not used)
+    // or constraint (MAX_PARAMETERS, MAX_MEMORY). The outputs are appended to the blackbox outputs in this order.
+    struct SizeOutput
+    {
+        SizeOutputType type;
+        double bound;
+        NOMAD::bb_output_type bbot;
+    };
+    
+    // Output requested from the blackbox after the objective (HYPERNOMAD_OUTPUTS environment variable):
+    // objective (SECOND_OBJECTIVE, the bound is not used) or constraint (MAX_LATENCY).
+    // The blackbox gives the value, the constraint is value / bound - 1.
+    struct ExtraOutput
+    {
+        std::string name;
+        double bound;
+        NOMAD::bb_output_type bbot;
+    };
+    
 private:
     
     enum class ReportValueType { NO_REPORT, COPY_VALUE, COPY_INITIAL_VALUE } ;
@@ -75,6 +135,25 @@ private:
     
     typedef std::vector<std::vector<GenericHyperParameter>> GroupsOfAssociatedHyperParameters;
     
+    // Read the coordinates of a point from left to right when updating the blocks.
+    // isDefined() is true while a defined coordinate remains (same as NOMAD::Point::is_defined on the remaining coordinates).
+    class PointReader
+    {
+    private:
+        const NOMAD::Point & _x;
+        size_t _next;
+        size_t _end; // One past the last defined coordinate
+        
+    public:
+        explicit PointReader ( const NOMAD::Point & x );
+        
+        bool isDefined ( ) const { return _next < _end; }
+        size_t remaining ( ) const { return static_cast<size_t>(_x.size()) - _next; }
+        
+        // Get the next coordinate and move forward
+        const NOMAD::Double & next ( );
+    };
+    
     struct HyperParametersBlock
     {
         
@@ -94,6 +173,10 @@ private:
         
         GroupsOfAssociatedHyperParameters groupsOfAssociatedHyperParameters;
         
+        // The group of associated parameters given by the schema (shared by all copies of the block).
+        // Used when a group must be created and there is no group to copy.
+        std::shared_ptr<const std::vector<GenericHyperParameter>> defaultGroupOfAssociatedHyperParameters;
+        
         //---------------------------------------------//
         // Utility functions follow
         //---------------------------------------------//
@@ -102,10 +185,12 @@ private:
         void expandAssociatedParameters(); // Expanding baseHyperParameter -> expandHyperParameter
         
         // Update the values of all the associated parameters using values in x
-        void updateAssociatedParameters( NOMAD::Point & x , NOMAD::Point & lb , NOMAD::Point & ub );
+        void updateAssociatedParameters( PointReader & x , PointReader & lb , PointReader & ub );
         
         // Get an updated group of associated hyper parameters
-        std::vector<GenericHyperParameter> updateAssociatedParameters ( std::vector<GenericHyperParameter> & fromGroup  ) const;
+        std::vector<GenericHyperParameter> updateAssociatedParameters ( const std::vector<GenericHyperParameter> & fromGroup  ) const;
+        
+        const std::vector<GenericHyperParameter> & getDefaultGroupOfAssociatedParameters ( ) const;
         
         void expandAndUpdateAssociatedParametersWithConstraints( ); // increase to match head parameter value
 
@@ -125,13 +210,7 @@ private:
         
         std::vector<NOMAD::bb_input_type> getTypes(  ) const;
         std::vector<NOMAD::Double> getValues( ValueType t ) const;
-        std::vector<HyperParametersBlock> getNeighboorsOfBlock( ) const;
-        
-        std::vector<std::string> getSearchNames() const;
-        
-        
-        // Get an hyper parameter to perform modification
-        GenericHyperParameter* getHyperParameter( const std::string & searchName ) ;
+        std::vector<HyperParametersBlock> getNeighboorsOfBlock( const NeighborhoodOptions & options ) const;
         
         void check();
         
@@ -142,22 +221,59 @@ private:
     std::vector<HyperParametersBlock> _baseHyperParameters;
     std::vector<HyperParametersBlock> _expandedHyperParameters;
     
+    // Location of a registered hyperparameter in the base blocks
+    struct SearchNameLocation
+    {
+        size_t block;
+        int groupSlot; // -1 for the head of block
+        size_t offset; // position in the group of associated hyperparameters
+    };
+    
+    // Search names in order of registration and index from search name to location
     std::vector<std::string> _allSearchNames;
+    std::unordered_map<std::string,SearchNameLocation> _searchNameIndex;
     
     std::string _dataset;
     std::string _bbEXE;
     std::string _sgteEXE;
+    std::string _bbWorkerEXE;
+    bool _sharedMemoryTransfer;
+    bool _defaultBB;
     std::vector<NOMAD::bb_output_type> _bbot;
     size_t _maxBbEval;
+    size_t _bbMaxBlockSize;
     std::list<std::string> _registeredDataset;
 
     
     NOMAD::Point _X0, _lowerBound, _upperBound , _fixedVariables;
     
+    // Points given with X0 after the first one
+    std::vector<NOMAD::Point> _otherX0s;
+    
     size_t _hyperDisplay;
     
     size_t _lhIterationSearch;
     
+    size_t _initialDesignSize;
+    
+    size_t _replications;
+    
+    size_t _coSchedulingNetworks;
+    double _coSchedulingMaxParameters;
+    
+    double _maxEvalTime;
+    double _evalTimeMedianFactor;
+    size_t _maxEpochs;
+    
+    NeighborhoodOptions _neighborhoodOptions;
+    
+    std::vector<std::string> _warmStartFiles;
+    size_t _warmStartPoints;
+    
+    std::vector<SizeOutput> _sizeOutputs;
+    
+    std::vector<ExtraOutput> _extraOutputs;
+    
     bool _explicitSetLowerBounds;
     bool _explicitSetUpperBounds;
     bool _explicitSetX0;
@@ -172,19 +288,20 @@ private:
     // for _baseHyperParameters only
     GenericHyperParameter * getHyperParameter( const std::string & searchName ) ;
     
-    void initBlockStructureToDefault ( void );
+    // Block structure from the schema given in the file (SEARCH_SPACE_SCHEMA) or from the default schema
+    void initBlockStructure ( const HyperParametersFile & hyperParamFile );
     
-    static GroupsOfAssociatedHyperParameters createGroupsOfAssociatedParameters(const std::string & blockName);
+    void compileSchema ( const HyperParametersFile & schema );
     
     HyperParameters ( const std::vector<HyperParametersBlock> & hpbs);
 
-    void read ( const std::string & hyperParamFileName );
+    void read ( const HyperParametersFile & file );
     
     void updateAndCheckAfterReading();
     
-    void interpretX0( NOMAD::Parameter_Entries * entries ) ;
+    void interpretX0( const HyperParametersFile & file ) ;
     
-    void interpretBoundsAndFixed( const std::string & paramName , const NOMAD::Parameter_Entries & entries , NOMAD::Point & param ) ;
+    void interpretBoundsAndFixed( const std::string & paramName , const HyperParametersFile & file , NOMAD::Point & param ) ;
     
 public:
     
@@ -194,10 +311,16 @@ public:
     
     NOMAD::Point getValues( ValueType t ) const;
     
+    const std::string & getDataset ( void ) const { return _dataset;  }
     const std::string & getBB ( void ) const { return _bbEXE;  }
     const std::string & getSGTE ( void ) const { return _sgteEXE;  }
+    const std::string & getBBWorker ( void ) const { return _bbWorkerEXE;  }
+    bool isSharedMemoryTransfer ( void ) const { return _sharedMemoryTransfer; }
+    // The default blackbox (scripts of HYPERNOMAD_HOME) is used when BB_EXE is not given
+    bool isDefaultBB ( void ) const { return _defaultBB; }
     const vector<NOMAD::bb_output_type> & getBbOutputType ( void ) const { return _bbot; }
     size_t getMaxBbEval( void ) const { return _maxBbEval; }
+    size_t getBbMaxBlockSize( void ) const { return _bbMaxBlockSize; }
     
     size_t getDimension( void ) const;
     
@@ -208,13 +331,58 @@ public:
     std::vector<size_t> getIndexFixedParams() const;
     std::vector<std::set<int>> getVariableGroupsIndices() const;
     
+    // All the neighboors, in the order of the blocks. Nomad evaluates them in the order of the priorities given by
+    // the evaluator from the cost model (see HyperEvaluator::list_of_points_preprocessing).
     std::vector<HyperParameters> getNeighboors( const NOMAD::Point & x ) ;
     
+    const NeighborhoodOptions & getNeighborhoodOptions () const { return _neighborhoodOptions ;}
+    
     void setHyperDisplay ( size_t d ) { _hyperDisplay = d; }
     size_t getHyperDisplay() const { return _hyperDisplay ;}
     
     size_t getLhIterationSearch () const { return _lhIterationSearch ;}
     
+    size_t getInitialDesignSize () const { return _initialDesignSize ;}
+    
+    size_t getReplications () const { return _replications ;}
+    
+    // Maximum number of small networks trained in one process (1: no co-scheduling) and size of a small network
+    size_t getCoSchedulingNetworks () const { return _coSchedulingNetworks ;}
+    double getCoSchedulingMaxParameters () const { return _coSchedulingMaxParameters ;}
+    
+    // Time budget of an evaluation in seconds (0: none) and factor of the median time for the adaptive budget (0: none)
+    double getMaxEvalTime () const { return _maxEvalTime ;}
+    double getEvalTimeMedianFactor () const { return _evalTimeMedianFactor ;}
+    
+    // Maximum number of epochs given to the blackbox (0: default of the blackbox)
+    size_t getMaxEpochs () const { return _maxEpochs ;}
+    
+    // Histories of previous campaigns (WARM_START) and number of their points evaluated with the initial design
+    const std::vector<std::string> & getWarmStartFiles () const { return _warmStartFiles ;}
+    size_t getWarmStartPoints () const { return _warmStartPoints ;}
+    
+    const std::vector<SizeOutput> & getSizeOutputs () const { return _sizeOutputs ;}
+    
+    // The outputs are the objective, the extra outputs and the size outputs
+    const std::vector<ExtraOutput> & getExtraOutputs () const { return _extraOutputs ;}
+    
+    size_t getNbObjectives () const { return std::count( _bbot.begin() , _bbot.end() , NOMAD::OBJ ) ;}
+    
+    // Latin hypercube design across structures (INITIAL_DESIGN points)
+    std::vector<NOMAD::Point> getInitialDesign ( ) const;
+    
+    bool hasCurrentStructure ( const NOMAD::Point & x ) const;
+    
+    // Point of another campaign in the current search space (false if it does not have the blocks of the schema)
+    bool projectPoint ( const NOMAD::Point & x , NOMAD::Point & projected ) const;
+    
+    void setX0 ( const NOMAD::Point & x );
+    
+    // Starting points given with X0 after the first one (evaluated with the initial design)
+    const std::vector<NOMAD::Point> & getOtherX0s ( ) const { return _otherX0s; }
+    
+    std::vector<BlockLayout> getBlockLayout ( ) const;
+    
     void display() const;
 
 };
@@ -0,0 +1,261 @@
+//
+//  hyperParametersFile.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "hyperParametersFile.hpp"
+
+#include <cstring>
+#include <cctype>
+
+void HyperParametersFile::read ( const std::string & fileName )
+{
+    std::ifstream fin;
+    std::string err = "Cannot read " + fileName ;
+    if ( NOMAD::check_read_file ( fileName ) )
+    {
+        fin.open ( fileName.c_str() , std::ios::in | std::ios::binary );
+        if ( !fin.fail() )
+            err.clear();
+    }
+    if ( !err.empty() )
+    {
+        fin.close();
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , err );
+    }
+
+    // Read once into the buffer
+    _fileName = fileName;
+    fin.seekg ( 0 , std::ios::end );
+    std::streamoff size = fin.tellg();
+    fin.seekg ( 0 , std::ios::beg );
+
+    _buffer.clear();
+    if ( size > 0 )
+    {
+        _buffer.resize ( static_cast<size_t>(size) );
+        fin.read ( &_buffer[0] , size );
+        if ( fin.gcount() != size )
+        {
+            fin.close();
+            throw NOMAD::Exception ( __FILE__ , __LINE__ , err );
+        }
+    }
+    fin.close();
+
+    tokenize();
+    buildTable();
+}
+
+void HyperParametersFile::parse ( const std::string & content , const std::string & sourceName )
+{
+    _fileName = sourceName;
+    _buffer = content;
+
+    tokenize();
+    buildTable();
+}
+
+// Split the buffer into tokens. Each non empty line gives an entry.
+// Brackets are single tokens (same as Nomad padding of vector forms), quoted strings are single tokens (quotes removed)
+// and a token starting with # starts a comment up to the end of the line.
+void HyperParametersFile::tokenize ( void )
+{
+    _tokens.clear();
+    _entries.clear();
+
+    // Rough estimate to avoid reallocation while tokenizing
+    _tokens.reserve( _buffer.size() / 4 + 1 );
+
+    const size_t n = _buffer.size();
+    size_t pos = 0;
+    int line = 0;
+
+    while ( pos < n )
+    {
+        line++;
+
+        size_t firstToken = _tokens.size();
+
+        // Tokens of the current line
+        while ( pos < n && _buffer[pos] != '\n' )
+        {
+            char c = _buffer[pos];
+
+            if ( c == ' ' || c == '\t' || c == '\r' )
+            {
+                pos++;
+                continue;
+            }
+
+            // Comment: skip the rest of the line
+            if ( c == '#' )
+            {
+                while ( pos < n && _buffer[pos] != '\n' )
+                    pos++;
+                break;
+            }
+
+            if ( c == '(' || c == ')' || c == '[' || c == ']' )
+            {
+                _tokens.push_back( { pos , 1 } );
+                pos++;
+                continue;
+            }
+
+            if ( c == '"' || c == '\'' )
+            {
+                size_t begin = ++pos;
+                while ( pos < n && _buffer[pos] != c && _buffer[pos] != '\n' )
+                    pos++;
+                if ( pos >= n || _buffer[pos] != c )
+                    throw NOMAD::Parameters::Invalid_Parameter ( _fileName , line , "missing closing quote." );
+                _tokens.push_back( { begin , pos - begin } );
+                pos++;
+                continue;
+            }
+
+            size_t begin = pos;
+            while ( pos < n )
+            {
+                c = _buffer[pos];
+                if ( c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '(' || c == ')' || c == '[' || c == ']' )
+                    break;
+                pos++;
+            }
+            _tokens.push_back( { begin , pos - begin } );
+        }
+
+        // Skip end of line
+        pos++;
+
+        if ( _tokens.size() == firstToken )
+            continue;
+
+        // The keyword is case insensitive: put it in upper case directly into the buffer
+        Token & name = _tokens[firstToken];
+        for ( size_t i = name.begin ; i < name.begin + name.size ; i++ )
+            _buffer[i] = static_cast<char>( std::toupper( static_cast<unsigned char>( _buffer[i] ) ) );
+
+        size_t nbValues = _tokens.size() - firstToken - 1;
+        if ( nbValues == 0 )
+        {
+            std::string err = _buffer.substr( name.begin , name.size ) + " does not respect parameters syntax.";
+            throw NOMAD::Parameters::Invalid_Parameter ( _fileName , line , err );
+        }
+
+        _entries.push_back( { line , firstToken , firstToken + 1 , nbValues , -1 , true , false } );
+    }
+}
+
+// FNV-1a
+size_t HyperParametersFile::hash ( const char * s , size_t size )
+{
+    size_t h = 2166136261u;
+    for ( size_t i = 0 ; i < size ; i++ )
+    {
+        h ^= static_cast<unsigned char>( s[i] );
+        h *= 16777619u;
+    }
+    return h;
+}
+
+void HyperParametersFile::buildTable ( void )
+{
+    // Power of two at least twice the number of entries
+    size_t tableSize = 16;
+    while ( tableSize < 2 * _entries.size() )
+        tableSize *= 2;
+
+    _table.assign( tableSize , -1 );
+    _chainTail.assign( tableSize , -1 );
+
+    for ( size_t i = 0 ; i < _entries.size() ; i++ )
+    {
+        const Token & name = _tokens[_entries[i].nameToken];
+        const char * s = _buffer.data() + name.begin;
+
+        size_t slot = hash( s , name.size ) & ( tableSize - 1 );
+        while ( _table[slot] >= 0 )
+        {
+            if ( equals( _tokens[_entries[_table[slot]].nameToken] , s , name.size ) )
+                break;
+            slot = ( slot + 1 ) & ( tableSize - 1 );
+        }
+
+        if ( _table[slot] < 0 )
+            _table[slot] = static_cast<int>(i);
+        else
+        {
+            // Keyword given several times: chain the entries
+            _entries[_chainTail[slot]].next = static_cast<int>(i);
+            _entries[_table[slot]].unique = false;
+        }
+        _chainTail[slot] = static_cast<int>(i);
+    }
+}
+
+bool HyperParametersFile::equals ( const Token & t , const char * s , size_t size ) const
+{
+    return t.size == size && std::memcmp( _buffer.data() + t.begin , s , size ) == 0;
+}
+
+const HyperParametersFile::Entry * HyperParametersFile::find ( const std::string & name ) const
+{
+    if ( _table.empty() )
+        return nullptr;
+
+    const size_t mask = _table.size() - 1;
+    size_t slot = hash( name.data() , name.size() ) & mask;
+    while ( _table[slot] >= 0 )
+    {
+        const Entry & e = _entries[_table[slot]];
+        if ( equals( _tokens[e.nameToken] , name.data() , name.size() ) )
+            return &e;
+        slot = ( slot + 1 ) & mask;
+    }
+    return nullptr;
+}
+
+const HyperParametersFile::Entry * HyperParametersFile::findNonInterpreted ( void ) const
+{
+    for ( const auto & e : _entries )
+    {
+        if ( ! e.hasBeenInterpreted )
+            return &e;
+    }
+    return nullptr;
+}
+
+std::string HyperParametersFile::getName ( const Entry & e ) const
+{
+    const Token & t = _tokens[e.nameToken];
+    return _buffer.substr( t.begin , t.size );
+}
+
+std::string HyperParametersFile::getValue ( const Entry & e , size_t i ) const
+{
+    if ( i >= e.nbValues )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "HyperParametersFile: not enough values for " + getName( e ) );
+
+    const Token & t = _tokens[e.firstValueToken + i];
+    return _buffer.substr( t.begin , t.size );
+}
+
+bool HyperParametersFile::valueEquals ( const Entry & e , size_t i , const std::string & s ) const
+{
+    if ( i >= e.nbValues )
+        return false;
+    return equals( _tokens[e.firstValueToken + i] , s.data() , s.size() );
+}
+
+bool HyperParametersFile::getValue ( const Entry & e , size_t i , NOMAD::Double & v ) const
+{
+    if ( i >= e.nbValues )
+        return false;
+
+    // Short values fit in the small string buffer: no heap allocation
+    return v.atof( getValue( e , i ) );
+}
@@ -0,0 +1,117 @@
+//
+//  hyperParametersFile.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __HYPERPARAMETERSFILE__
+#define __HYPERPARAMETERSFILE__
+
+#include "nomad.hpp"
+
+// Single pass reader of an hyperparameters file.
+// The file is read once into a buffer and tokenized in place: tokens and entries
+// only store offsets in the buffer (no allocation per line).
+// Entries are registered in a keyword hash table. Entries with the same keyword are chained.
+// The syntax follows the Nomad parameter files: KEYWORD value1 value2 ... # comment
+class HyperParametersFile
+{
+public:
+
+    struct Token
+    {
+        size_t begin;
+        size_t size;
+    };
+
+    struct Entry
+    {
+        int line;
+        size_t nameToken;
+        size_t firstValueToken;
+        size_t nbValues;
+
+        // Index of the next entry with the same keyword (-1 for none)
+        int next;
+
+        // Set to false for the first entry of a keyword given several times
+        bool unique;
+
+        mutable bool hasBeenInterpreted;
+    };
+
+private:
+
+    std::string _fileName;
+    std::string _buffer;
+
+    std::vector<Token> _tokens;
+    std::vector<Entry> _entries;
+
+    // Open addressing hash table: index of the first entry of a keyword (-1 for empty slot)
+    std::vector<int> _table;
+    std::vector<int> _chainTail;
+
+    static size_t hash ( const char * s , size_t size );
+
+    void tokenize ( void );
+    void buildTable ( void );
+
+    bool equals ( const Token & t , const char * s , size_t size ) const;
+
+public:
+
+    HyperParametersFile ( void ) {}
+
+    // Read and tokenize a file. Throw a NOMAD::Exception if the file cannot be read.
+    void read ( const std::string & fileName );
+
+    // Tokenize the given content. The source name is used for error messages.
+    void parse ( const std::string & content , const std::string & sourceName );
+
+    const std::string & getFileName ( void ) const { return _fileName; }
+
+    const std::vector<Entry> & getEntries ( void ) const { return _entries; }
+
+    // First entry for a keyword (nullptr if the keyword is not in file)
+    const Entry * find ( const std::string & name ) const;
+
+    // Next entry with the same keyword (nullptr if none)
+    const Entry * getNext ( const Entry & e ) const { return ( e.next < 0 ) ? nullptr : &_entries[e.next]; }
+
+    const Entry * findNonInterpreted ( void ) const;
+
+    void setInterpreted ( const Entry & e ) const { e.hasBeenInterpreted = true; }
+
+    std::string getName ( const Entry & e ) const;
+    std::string getValue ( const Entry & e , size_t i ) const;
+
+    // Compare a value without making a copy
+    bool valueEquals ( const Entry & e , size_t i , const std::string & s ) const;
+
+    // Value converted with Nomad rules ('-' is undefined). Return false if the conversion fails.
+    bool getValue ( const Entry & e , size_t i , NOMAD::Double & v ) const;
+
+};
+
+#endif
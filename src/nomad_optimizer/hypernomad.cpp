@@ -25,6 +25,10 @@
 /*-------------------------------------------------------------------*/
 #include "nomad.hpp"
 #include "hyperParameters.hpp"
+#include "hyperEvaluator.hpp"
+#include "hyperExtendedPoll.hpp"
+#include "campaign.hpp"
+#include "defaultSchema.hpp"
 #include <vector>
 #include <memory>
 
@@ -40,34 +44,6 @@ const std::string shortPytorchSGTEPath = "src" + std::string(dirSep) + "blackbox
 const std::string hyperNomadVersion = "1.0";
 
 
-/*--------------------------------------------------*/
-/*  user class to define categorical neighborhoods  */
-/*--------------------------------------------------*/
-class My_Extended_Poll : public Extended_Poll
-{
-
-private:
-
-    // vector of signatures
-    int _extended_poll_call;
-    std::shared_ptr<HyperParameters> _hyperParameters;
-
-public:
-
-    // constructor:
-    My_Extended_Poll ( Parameters & p , std::shared_ptr<HyperParameters> & hyperParameters ):
-    Extended_Poll ( p ), _hyperParameters(std::move(hyperParameters))
-    {
-    }
-
-    // destructor:
-    virtual ~My_Extended_Poll ( void ) {}
-
-    // construct the extended poll points:
-    virtual void construct_extended_points ( const Eval_Point &);
-
-};
-
 void display_hyperusage( )
 {
     cout << std::endl
@@ -77,6 +53,8 @@ void display_hyperusage( )
     << "Version       : " << hyperNomadName << " -v"                       << std::endl
     << "Usage         : " << hyperNomadName << " -u"                       << std::endl
     << "Neighboors    : " << hyperNomadName << " -n parameters_file"  << std::endl
+    << "Batch         : " << hyperNomadName << " -b manifest_file (campaigns run one after the other)" << std::endl
+    << "Schema        : " << hyperNomadName << " -s"                       << std::endl
     << std::endl;
 }
 
@@ -115,6 +93,12 @@ void display_hyperhelp()
     std::cout << " Default: $python $(HYPERNOMAD)/" + shortPytorchBBPath << std::endl;
     std::cout << NOMAD::close_block() << std::endl;
 
+    std::cout << NOMAD::open_block("BB_EXE synthetic:FUNCTION[:SLEEP_MS[:NOISE]]") << std::endl;
+    std::cout << " Analytic blackbox evaluated in process to measure the overhead of HyperNomad." << std::endl;
+    std::cout << " FUNCTION: SPHERE, LAYERS or RASTRIGIN. SLEEP_MS emulates the training time." << std::endl;
+    std::cout << " NOISE: standard deviation of a gaussian noise added to the objective." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+
     std::cout << NOMAD::open_block("HYPER_DISPLAY") << std::endl;
     std::cout << " Default: 1 " << std::endl;
     std::cout << NOMAD::close_block() << std::endl;
@@ -125,6 +109,9 @@ void display_hyperhelp()
 
     std::cout << NOMAD::open_block("X0") << std::endl;
     std::cout << " Default:  " << std::endl;
+    std::cout << " X0 ( values ) or X0 points_file (one point per line). X0 can be given several times: the points can have" << std::endl;
+    std::cout << " different structures. The first point gives the fixed values, the others are clipped to the bounds." << std::endl;
+    std::cout << " All the points are evaluated simultaneously with the initial design and the best one is the poll center." << std::endl;
     std::cout << NOMAD::close_block() << std::endl;
 
     std::cout << NOMAD::open_block("LOWER_BOUND") << std::endl;
@@ -143,7 +130,239 @@ void display_hyperhelp()
     std::cout << " Default: VAR " << std::endl;
     std::cout << NOMAD::close_block() << std::endl;
     
+    std::cout << NOMAD::open_block("INITIAL_DESIGN") << std::endl;
+    std::cout << " Default: 0 (no initial design)" << std::endl;
+    std::cout << " Number of points of a latin hypercube design evaluated before the optimization." << std::endl;
+    std::cout << " The head of blocks are sampled within their bounds: the points have different structures." << std::endl;
+    std::cout << " The points are evaluated simultaneously by the workers and the best one replaces X0." << std::endl;
+    std::cout << " The evaluations are part of MAX_BB_EVAL." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("NEIGHBORHOOD") << std::endl;
+    std::cout << " Default: 1" << std::endl;
+    std::cout << " NEIGHBORHOOD max_step [DUPLICATE_LAYER] [REMOVE_LAYER] [CHANGE_LAYER]: neighbors of the extended poll." << std::endl;
+    std::cout << " The number of layers (head of blocks with +1/-1 neighbors) changes by +-1, ..., +-max_step." << std::endl;
+    std::cout << " DUPLICATE_LAYER copies a layer next to itself, REMOVE_LAYER removes a layer inside the network and" << std::endl;
+    std::cout << " CHANGE_LAYER gives to a layer the values of the previous layer." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("WARM_START") << std::endl;
+    std::cout << " Default: none" << std::endl;
+    std::cout << " WARM_START history_file [history_file ...]: history.txt files of previous campaigns, possibly on" << std::endl;
+    std::cout << " other datasets (a file ending with .bin is a Nomad cache file). Relative path is relative to the" << std::endl;
+    std::cout << " hyperparameters file. The objectives are ranked in each file and a model on the points of all the files" << std::endl;
+    std::cout << " predicts the rank of a point. The best points (WARM_START_POINTS, default: 5) are clipped to the bounds" << std::endl;
+    std::cout << " and evaluated with the initial design: the best point of the design replaces X0." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("BB_MAX_BLOCK_SIZE") << std::endl;
+    std::cout << " Default: 1 (number of points evaluated simultaneously) " << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("BB_TRANSFER") << std::endl;
+    std::cout << " Default: FILE (input file and command line as Nomad)" << std::endl;
+    std::cout << " SHARED_MEMORY: points and outputs are given as doubles in shared memory to persistent workers" << std::endl;
+    std::cout << " of the default blackbox (src/blackbox/shm_worker.py), one per worker. Not available on Windows." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("MAX_EVAL_TIME") << std::endl;
+    std::cout << " Default: none" << std::endl;
+    std::cout << " MAX_EVAL_TIME seconds [median_factor]: the blackbox is killed after the time budget (failed evaluation" << std::endl;
+    std::cout << " written in censored.txt). With median_factor > 1, the budget is reduced to median_factor times the" << std::endl;
+    std::cout << " median time of the completed evaluations (after 5 evaluations). Not available on Windows." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("MAX_EPOCHS") << std::endl;
+    std::cout << " Default: none (100 epochs, 50 for MINIMNIST)" << std::endl;
+    std::cout << " Maximum number of training epochs of the default blackbox (HYPERNOMAD_MAX_EPOCHS)." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("CO_SCHEDULING") << std::endl;
+    std::cout << " Default: none" << std::endl;
+    std::cout << " CO_SCHEDULING max_networks max_parameters: networks with at most max_parameters trainable parameters" << std::endl;
+    std::cout << " and the same batch size are trained together (same data batches) by packs of at most max_networks" << std::endl;
+    std::cout << " in one process of the default blackbox, when a block has more points to launch than workers." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("REPLICATIONS") << std::endl;
+    std::cout << " Default: 1 (no replication)" << std::endl;
+    std::cout << " Number of evaluations with different seeds (HYPERNOMAD_SEED) of a feasible point better than the incumbent." << std::endl;
+    std::cout << " The objective is the mean. The point becomes the incumbent only if it is significantly better (Welch t-test at 95%)." << std::endl;
+    std::cout << " Replications during the optimization are not counted in MAX_BB_EVAL." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("SECOND_OBJECTIVE") << std::endl;
+    std::cout << " Default: none (single objective)" << std::endl;
+    std::cout << " TRAINING_TIME or LATENCY (outputs of the blackbox), PARAMETERS or MEMORY (computed from the network)." << std::endl;
+    std::cout << " Bi-objective optimization with BiMads. The non dominated points are written in pareto.txt." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("MAX_PARAMETERS, MAX_MEMORY") << std::endl;
+    std::cout << " Default: none" << std::endl;
+    std::cout << " MAX_PARAMETERS bound [PB|EB]: maximum number of trainable parameters of the network." << std::endl;
+    std::cout << " MAX_MEMORY bound [PB|EB]: maximum memory for training in MB (estimate)." << std::endl;
+    std::cout << " Computed without the blackbox. With EB (default), a network exceeding the bound is not trained." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("MAX_LATENCY") << std::endl;
+    std::cout << " Default: none" << std::endl;
+    std::cout << " MAX_LATENCY bound [PB|EB]: maximum inference latency in ms (batch of 1 on CPU) measured by the blackbox." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("SEARCH_SPACE_SCHEMA") << std::endl;
+    std::cout << " Default: the default schema (displayed with -s option)" << std::endl;
+    std::cout << " File describing the blocks of hyperparameters. Relative path is relative to the hyperparameters file." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+    std::cout << NOMAD::open_block("Batch manifest file (-b option)") << std::endl;
+    std::cout << " CAMPAIGN hyperparameters_file (one line per campaign)" << std::endl;
+    std::cout << " WORKERS  number of workers shared by the campaigns (default: 1)" << std::endl;
+    std::cout << " The campaigns run one after the other (not concurrently) in a single process, with the same workers and" << std::endl;
+    std::cout << " cache of evaluations. For concurrent campaigns, start one process per campaign." << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
+    
+}
+
+
+/*------------------------------------------------------------------*/
+/*  The scripts of the default blackbox are needed only when BB_EXE */
+/*  is not given (no check at startup for a synthetic blackbox or   */
+/*  a user blackbox).                                               */
+/*------------------------------------------------------------------*/
+void checkDefaultBlackbox ( const HyperParameters & hyperParameters , const std::string & pytorchBB , const std::string & pytorchSGTE )
+{
+    if ( ! hyperParameters.isDefaultBB() )
+        return;
+    
+    if ( getenv ("HYPERNOMAD_HOME") == nullptr )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "Cannot access HYPERNOMAD_HOME environment variable. Make sure to define it properly." );
+    
+    if ( ! checkAccess( pytorchBB ) )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "Cannot access to " + pytorchBB + ". Make sure to set the HYPERNOMAD_HOME environment variable properly." );
+    
+    if ( ! checkAccess( pytorchSGTE ) )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "Cannot access to " + pytorchSGTE + ". Make sure to set the HYPERNOMAD_HOME environment variable properly." );
+}
+
+
+/*------------------------------------------------------------------*/
+/*  Run a campaign (optimization for a single hyperparameters file) */
+/*  The worker pool and the cache of evaluations can be shared      */
+/*  between campaigns. The prefix is added to the output file names */
+/*------------------------------------------------------------------*/
+NOMAD::stop_type runCampaign ( const std::string & hyperParamFile , const std::string & pytorchBB , const std::string & pytorchSGTE , const Display & out , std::shared_ptr<WorkerPool> workerPool , std::shared_ptr<EvaluationCache> cache , const std::string & filePrefix )
+{
+    std::shared_ptr<HyperParameters> hyperParameters = std::make_shared<HyperParameters>(hyperParamFile , pytorchBB , pytorchSGTE );
+    
+    checkDefaultBlackbox( *hyperParameters , pytorchBB , pytorchSGTE );
+    
+    // A campaign run alone has its own workers (see Campaign)
+    Campaign campaign ( hyperParameters , out , workerPool , cache );
+    campaign.setOutputFiles( filePrefix );
+    
+    if ( hyperParameters->getHyperDisplay() > 2 )
+        display_hyperversion();
+    
+    NOMAD::stop_type stopType = campaign.run();
+    
+    Campaign::Stats stats = campaign.getStats();
+    
+    if ( stats.nbRejected > 0 && hyperParameters->getHyperDisplay() > 0 )
+        std::cout << "Points rejected before training (network cannot be built or exceeds an EB size constraint): " << stats.nbRejected << std::endl;
     
+    if ( stats.nbTimedOut > 0 && hyperParameters->getHyperDisplay() > 0 )
+        std::cout << "Evaluations stopped after their time budget (MAX_EVAL_TIME): " << stats.nbTimedOut << " in " << filePrefix << "censored.txt" << std::endl;
+    
+    if ( campaign.getParetoArchive() && hyperParameters->getHyperDisplay() > 0 )
+        std::cout << "Pareto front: " << campaign.getParetoArchive()->size() << " points in " << filePrefix << "pareto.txt" << std::endl;
+    
+    if ( hyperParameters->getReplications() > 1 && hyperParameters->getHyperDisplay() > 0 )
+        std::cout << "Replicated evaluations (not counted in MAX_BB_EVAL): " << stats.nbReplications << std::endl;
+    
+    if ( stopType == X0_FAIL )
+        cerr << endl << "The starting point cannot be evaluated. Please verify that the Pytorch script is available and runs correctly. The default setting for bbExe is " << hyperParameters->getBB() << ". Make sure it works correctly on its own." << endl << endl;
+    
+    return stopType;
+}
+
+
+/*---------------------------------------------------------------*/
+/*  Run all the campaigns listed in a manifest file in a single  */
+/*  process. Startup checks are done once, the campaigns share   */
+/*  the worker pool and the cache of evaluations. The campaigns  */
+/*  run one after the other: Mads of Nomad 3 has static state.   */
+/*---------------------------------------------------------------*/
+void runBatch ( const std::string & manifestFileName , const std::string & pytorchBB , const std::string & pytorchSGTE , const Display & out )
+{
+    HyperParametersFile manifest;
+    manifest.read( manifestFileName );
+    
+    const HyperParametersFile::Entry * pe;
+    
+    // WORKERS
+    size_t nbWorkers = 1;
+    pe = manifest.find( "WORKERS" );
+    if ( pe )
+    {
+        int i;
+        if ( !pe->unique || pe->nbValues != 1 || !NOMAD::atoi ( manifest.getValue( *pe , 0 ) , i ) || i < 1 )
+            throw NOMAD::Parameters::Invalid_Parameter ( manifestFileName , pe->line , "WORKERS" );
+        nbWorkers = i;
+        manifest.setInterpreted( *pe );
+    }
+    
+    // CAMPAIGN (one entry per campaign, relative paths are relative to the manifest)
+    std::vector<std::string> campaigns;
+    for ( pe = manifest.find( "CAMPAIGN" ) ; pe != nullptr ; pe = manifest.getNext( *pe ) )
+    {
+        if ( pe->nbValues != 1 )
+            throw NOMAD::Parameters::Invalid_Parameter ( manifestFileName , pe->line , "CAMPAIGN hyperparameters_file" );
+        
+        std::string campaign = manifest.getValue( *pe , 0 );
+        if ( campaign.substr( 0 , 1 ).compare( dirSep ) != 0 )
+            campaign = extractDir( manifestFileName ) + campaign;
+        campaigns.push_back( campaign );
+        
+        manifest.setInterpreted( *pe );
+    }
+    
+    pe = manifest.findNonInterpreted();
+    if ( pe )
+        throw NOMAD::Parameters::Invalid_Parameter ( manifestFileName , pe->line , manifest.getName( *pe ) + " - unknown" );
+    
+    if ( campaigns.empty() )
+        throw NOMAD::Parameters::Invalid_Parameter ( manifestFileName , 0 , "At least one CAMPAIGN must be provided." );
+    
+    std::shared_ptr<WorkerPool> workerPool = std::make_shared<WorkerPool>( nbWorkers );
+    std::shared_ptr<EvaluationCache> cache = std::make_shared<EvaluationCache>();
+    
+    std::vector<std::string> status;
+    for ( size_t i = 0 ; i < campaigns.size() ; i++ )
+    {
+        std::string name = trimDir( campaigns[i] );
+        name = name.substr( 0 , name.find_last_of( '.' ) );
+        
+        std::cout << std::endl << NOMAD::open_block( "Campaign #" + std::to_string(i) + ": " + campaigns[i] ) << std::endl;
+        try
+        {
+            // Output files of the campaign are prefixed by its name
+            NOMAD::stop_type stopType = runCampaign( campaigns[i] , pytorchBB , pytorchSGTE , out , workerPool , cache , name + "_" );
+            status.push_back( ( stopType == X0_FAIL ) ? "X0 failed" : "done" );
+        }
+        catch ( exception & e )
+        {
+            // A failed campaign does not stop the batch
+            cerr << endl << "Campaign " << campaigns[i] << " has been interrupted: " << e.what() << endl << endl;
+            status.push_back( "interrupted" );
+        }
+        std::cout << NOMAD::close_block() << std::endl;
+    }
+    
+    std::cout << std::endl << NOMAD::open_block( "Batch summary" ) << std::endl;
+    for ( size_t i = 0 ; i < campaigns.size() ; i++ )
+        std::cout << " " << campaigns[i] << ": " << status[i] << std::endl;
+    std::cout << " Evaluations in shared cache: " << cache->size() << " (cache hits: " << cache->getNbHits() << ")" << std::endl;
+    std::cout << NOMAD::close_block() << std::endl;
 }
 
 
@@ -161,37 +380,15 @@ int main ( int argc , char ** argv )
         return 0;
     }
     
-    // Detect hypernomad_home environment variable
+    // The default Python script paths are set relative to the HYPERNOMAD_HOME path.
+    // They are checked only when a campaign uses the default blackbox (no BB_EXE).
     const char * hyperNomadPath = getenv ("HYPERNOMAD_HOME");
-    if ( hyperNomadPath == nullptr )
-    {
-        std::cerr << "Cannot access HYPERNOMAD_HOME environment variable. Make sure to define it properly." << std::endl;
-        return 0;
-        
-    }
-
-    std::string pytorchBB = std::string(hyperNomadPath) + dirSep + shortPytorchBBPath;
-    // The default Python script path is set relative to the HYPERNOMAD path
-    // The script file are assessed for reading
-    if ( ! checkAccess( pytorchBB ) )
-    {
-        std::cerr << "Cannot access to " << pytorchBB << ". Make sure to set the HYPERNOMAD_HOME environment variable properly." << std::endl;
-        return 0;
-
-    }
-    
-    std::string pytorchSGTE = std::string(hyperNomadPath) + dirSep + shortPytorchSGTEPath;
-    // The default Python script path is set relative to the HYPERNOMAD path
-    // The script file are assessed for reading
-    if ( ! checkAccess( pytorchSGTE ) )
-    {
-        std::cerr << "Cannot access to " << pytorchSGTE << ". Make sure to set the HYPERNOMAD_HOME environment variable properly." << std::endl;
-        return 0;
-
-    }
-
+    std::string hyperNomadHome = ( hyperNomadPath == nullptr ) ? "" : hyperNomadPath;
+    std::string pytorchBB = hyperNomadHome + dirSep + shortPytorchBBPath;
+    std::string pytorchSGTE = hyperNomadHome + dirSep + shortPytorchSGTEPath;
     
     std::string hyperParamFile="";
+    std::string manifestFile="";
     if ( argc > 1 )
     {
         std::string mainArg = argv[1];
@@ -221,6 +418,19 @@ int main ( int argc , char ** argv )
                         return 0;
                     }
                     break;
+                case 's':
+                    std::cout << defaultSchema << std::endl;
+                    return 0;
+                    break;
+                case 'b':
+                    if ( argc == 3 )
+                        manifestFile = argv[2];
+                    else
+                    {
+                        display_hyperusage();
+                        return 0;
+                    }
+                    break;
                 default:
                     display_hyperusage();
                     return 0;
@@ -245,14 +455,11 @@ int main ( int argc , char ** argv )
     try
     {
         
-        // parameters creation:
-        Parameters p ( out );
-
-        std::shared_ptr<HyperParameters> hyperParameters = std::make_shared<HyperParameters>(hyperParamFile , pytorchBB , pytorchSGTE );
-
 	// For testing getNeighboors
         if ( flagDisplayNeighboors )
         {
+            std::shared_ptr<HyperParameters> hyperParameters = std::make_shared<HyperParameters>(hyperParamFile , pytorchBB , pytorchSGTE );
+            
             // Switch to full display
             hyperParameters->setHyperDisplay(3);
             
@@ -269,65 +476,10 @@ int main ( int argc , char ** argv )
             return 0;
         }
         
-        
-        p.set_DISPLAY_DEGREE( static_cast<int>( hyperParameters->getHyperDisplay() ) );
-
-        p.set_DIMENSION( static_cast<int>(hyperParameters->getDimension()) );
-        p.set_X0( hyperParameters->getValues( ValueType::CURRENT_VALUE) );
-        p.set_BB_INPUT_TYPE( hyperParameters->getTypes() );
-        p.set_LOWER_BOUND( hyperParameters->getValues( ValueType::LOWER_BOUND ) );
-        p.set_UPPER_BOUND( hyperParameters->getValues( ValueType::UPPER_BOUND ) );
-
-        std::vector<size_t> indexFixedParams = hyperParameters->getIndexFixedParams();
-        for ( auto i : indexFixedParams )
-            p.set_FIXED_VARIABLE( static_cast<int>(i) );
-
-        // Each block forms a VARIABLE GROUP in Nomad
-        std::vector<std::set<int>> variableGroupsIndices = hyperParameters->getVariableGroupsIndices();
-        
-        for ( auto aGroupIndices : variableGroupsIndices )
-            p.set_VARIABLE_GROUP( aGroupIndices );
-
-        p.set_BB_OUTPUT_TYPE ( hyperParameters->getBbOutputType() );
-        p.set_BB_EXE( hyperParameters->getBB() );
-        
-        p.set_SGTE_EXE(hyperParameters->getBB(), hyperParameters->getSGTE());
-        
-        p.set_LH_SEARCH(0 , static_cast<int>( hyperParameters->getLhIterationSearch() ) );
-
-        p.set_MAX_BB_EVAL( static_cast<int>( hyperParameters->getMaxBbEval()) );
-
-        p.set_EXTENDED_POLL_TRIGGER ( 10 , false );
-        
-        p.set_DISPLAY_STATS("bbe ( sol ) obj");
-        p.set_STATS_FILE("stats.txt","bbe ( sol ) obj");
-        p.set_HISTORY_FILE("history.txt");
-
-        // parameters validation:
-        p.check();
-        
-        if ( hyperParameters->getHyperDisplay() > 2 )
-        {
-            display_hyperversion();
-            
-            std::cout << std::endl
-                << NOMAD::open_block ( "Nomad parameters" ) << std::endl
-                << p
-                << NOMAD::close_block();
-            
-        }
-
-        // extended poll:
-        My_Extended_Poll ep ( p , hyperParameters );
-
-        // algorithm creation and execution:
-        Mads mads ( p , NULL , &ep , NULL , NULL );
-        
-        
-        NOMAD::stop_type stopType = mads.run();
-        
-        if ( stopType == X0_FAIL )
-            cerr << endl << "The starting point cannot be evaluated. Please verify that the Pytorch script is available and runs correctly. The default setting for bbExe is " << p.get_bb_exe().front() << ". Make sure it works correctly on its own." << endl << endl;
+        if ( ! manifestFile.empty() )
+            runBatch( manifestFile , pytorchBB , pytorchSGTE , out );
+        else
+            runCampaign( hyperParamFile , pytorchBB , pytorchSGTE , out , nullptr , nullptr , "" );
         
     }
     catch ( exception & e ) {
@@ -342,55 +494,3 @@ int main ( int argc , char ** argv )
 
     return EXIT_SUCCESS;
 }
-
-/*--------------------------------------*/
-/*  construct the extended poll points  */
-/*      (categorical neighborhoods)     */
-/*--------------------------------------*/
-void My_Extended_Poll::construct_extended_points ( const Eval_Point & x)
-{
-
-    // Get the neighboors of the point (an update of the hyper parameters structure is performed)
-    std::vector<HyperParameters> neighboors = _hyperParameters->getNeighboors(x);
-
-    for ( auto & nHyperParameters : neighboors )
-    {
-        size_t nDim = nHyperParameters.getDimension();
-        vector<bb_input_type> nBbit = nHyperParameters.getTypes();
-
-        NOMAD::Point nLowerBound = nHyperParameters.getValues( ValueType::LOWER_BOUND );
-        NOMAD::Point nUpperBound = nHyperParameters.getValues( ValueType::UPPER_BOUND );
-        NOMAD::Point nX = nHyperParameters.getValues( ValueType::CURRENT_VALUE );
-
-        // Create a parameter to obtain a signature for this neighboor
-        NOMAD::Parameters nP ( _p.out() );
-        nP.set_DIMENSION( static_cast<int>(nDim) );
-        nP.set_X0 ( nX );
-        nP.set_LOWER_BOUND( nLowerBound );
-        nP.set_UPPER_BOUND( nUpperBound );
-
-        nP.set_BB_INPUT_TYPE( nBbit );
-        nP.set_MESH_TYPE( NOMAD::XMESH );  // Need to force set XMesh
-
-        std::vector<size_t> indexFixed = nHyperParameters.getIndexFixedParams();
-        for ( auto i : indexFixed )
-            nP.set_FIXED_VARIABLE( static_cast<int>(i) );
-
-        // Each block forms a NOMAD VARIABLE GROUP
-        std::vector<std::set<int>> variableGroupsIndices = nHyperParameters.getVariableGroupsIndices();
-        for ( auto aGroupIndices : variableGroupsIndices )
-            nP.set_VARIABLE_GROUP( aGroupIndices );
-
-
-        // Some parameters come from the original problem definition
-        nP.set_BB_OUTPUT_TYPE( _p.get_bb_output_type() );
-        nP.set_BB_EXE( _p.get_bb_exe() );
-        // Check is need to create a valid signature
-        nP.check();
-
-        // The signature to be registered with the neighboor point
-        add_extended_poll_point ( nX , *(nP.get_signature()) );
-    }
-}
-
-
@@ -0,0 +1,61 @@
+//
+//  paretoArchive.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "paretoArchive.hpp"
+#include "hyperEvaluator.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+bool ParetoArchive::insert ( const NOMAD::Point & x , const NOMAD::Point & outputs , double f1 , double f2 )
+{
+    // First point with a larger first objective
+    auto it = std::upper_bound( _front.begin() , _front.end() , f1 , []( double f , const Entry & e ) { return f < e.f1; } );
+    
+    // Dominated by the previous point (first objective lower or equal)
+    if ( it != _front.begin() && std::prev( it )->f2 <= f2 )
+        return false;
+    
+    // Points dominated by the new one follow it: first objective larger or equal and second objective larger or equal
+    auto last = it;
+    while ( last != _front.end() && last->f2 >= f2 )
+        ++last;
+    
+    // A point with the same first objective (and a larger second objective) is just before
+    auto first = it;
+    if ( first != _front.begin() && std::prev( first )->f1 == f1 )
+        --first;
+    
+    it = _front.erase( first , last );
+    _front.insert( it , { x , outputs , f1 , f2 } );
+    return true;
+}
+
+bool ParetoArchive::write ( const std::string & fileName ) const
+{
+    const std::string tmpFileName = fileName + ".tmp";
+    
+    std::ofstream fout ( tmpFileName.c_str() );
+    if ( fout.fail() )
+        return false;
+    
+    // Values are read back exactly (as in the history)
+    for ( const Entry & e : _front )
+    {
+        HyperEvaluator::writeValues( fout , e.x );
+        HyperEvaluator::writeValues( fout , e.outputs );
+        fout << std::endl;
+    }
+    fout.close();
+    
+    if ( fout.fail() )
+        return false;
+    
+    return std::rename( tmpFileName.c_str() , fileName.c_str() ) == 0;
+}
@@ -0,0 +1,66 @@
+//
+//  paretoArchive.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __PARETOARCHIVE__
+#define __PARETOARCHIVE__
+
+#include "nomad.hpp"
+
+// Non dominated points of a bi-objective optimization (both objectives minimized).
+// The front is sorted by increasing first objective (the second objective is then decreasing):
+// an insertion is a binary search followed by the removal of the contiguous points it dominates.
+class ParetoArchive
+{
+public:
+    
+    struct Entry
+    {
+        NOMAD::Point x;
+        NOMAD::Point outputs;
+        double f1;
+        double f2;
+    };
+    
+private:
+    
+    std::vector<Entry> _front;
+    
+public:
+    
+    // Return false if the point is dominated by (or equal to) a point of the front
+    bool insert ( const NOMAD::Point & x , const NOMAD::Point & outputs , double f1 , double f2 );
+    
+    const std::vector<Entry> & getFront ( void ) const { return _front; }
+    
+    size_t size ( void ) const { return _front.size(); }
+    
+    // One line per point with the coordinates followed by the outputs (as in the history file).
+    // The file is replaced only when completely written.
+    bool write ( const std::string & fileName ) const;
+    
+};
+
+#endif
@@ -0,0 +1,302 @@
+//
+//  sharedMemoryRing.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "sharedMemoryRing.hpp"
+#include "fileutils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <new>
+#include <thread>
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#endif
+
+#ifdef _MSC_VER
+
+SharedMemoryRing::SharedMemoryRing ( const std::string & workerCommand , const Environment & environment , size_t nbSlots , size_t maxDimension , size_t maxOutputs ) :
+_workerCommand ( workerCommand ),
+_environment ( environment ),
+_nbSlots ( nbSlots ),
+_maxDimension ( maxDimension ),
+_maxOutputs ( maxOutputs ),
+_slotSize ( 0 ),
+_size ( 0 ),
+_memory ( nullptr ),
+_next ( 0 ),
+_nbTraces ( 0 )
+{
+    throw NOMAD::Exception ( __FILE__ , __LINE__ , "BB_TRANSFER SHARED_MEMORY is not available on Windows" );
+}
+
+SharedMemoryRing::~SharedMemoryRing ( void ) {}
+
+bool SharedMemoryRing::evaluate ( const NOMAD::Point & x , int seed , size_t nbOutputs , NOMAD::Point & outputs , std::string & traceFileName , double timeout , bool & timedOut )
+{
+    timedOut = false;
+    return false;
+}
+
+#else
+
+SharedMemoryRing::SharedMemoryRing ( const std::string & workerCommand , const Environment & environment , size_t nbSlots , size_t maxDimension , size_t maxOutputs ) :
+_workerCommand ( workerCommand ),
+_environment ( environment ),
+_nbSlots ( ( nbSlots > 0 ) ? nbSlots : 1 ),
+_maxDimension ( maxDimension ),
+_maxOutputs ( maxOutputs ),
+_slotSize ( sizeof( SlotHeader ) + sizeof( double ) * ( maxDimension + maxOutputs ) ),
+_size ( sizeof( Header ) + _nbSlots * _slotSize ),
+_memory ( nullptr ),
+_pids ( _nbSlots , 0 ),
+_busy ( _nbSlots , 0 ),
+_next ( 0 ),
+_nbTraces ( 0 )
+{
+    static_assert( sizeof( Header ) == 16 && sizeof( SlotHeader ) == 16 , "Layout of the shared memory read by shm_worker.py" );
+    
+    // One segment per ring (several campaigns can run in the same process)
+    static std::atomic<size_t> nbRings ( 0 );
+    _name = "/hypernomad." + std::to_string( getpid() ) + "." + std::to_string( nbRings++ );
+    
+    int fd = shm_open( _name.c_str() , O_CREAT | O_EXCL | O_RDWR , 0600 );
+    if ( fd < 0 )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "Cannot create the shared memory " + _name );
+    
+    if ( ftruncate( fd , static_cast<off_t>( _size ) ) != 0 )
+    {
+        close( fd );
+        shm_unlink( _name.c_str() );
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "Cannot allocate the shared memory " + _name );
+    }
+    
+    _memory = mmap( nullptr , _size , PROT_READ | PROT_WRITE , MAP_SHARED , fd , 0 );
+    close( fd );
+    if ( _memory == MAP_FAILED )
+    {
+        shm_unlink( _name.c_str() );
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "Cannot map the shared memory " + _name );
+    }
+    
+    Header * header = static_cast<Header *>( _memory );
+    header->magic = MAGIC;
+    header->nbSlots = static_cast<uint32_t>( _nbSlots );
+    header->maxDimension = static_cast<uint32_t>( _maxDimension );
+    header->maxOutputs = static_cast<uint32_t>( _maxOutputs );
+    
+    for ( size_t i = 0 ; i < _nbSlots ; i++ )
+    {
+        SlotHeader * slot = new ( getSlot( i ) ) SlotHeader;
+        slot->state.store( FREE );
+        slot->dimension = 0;
+        slot->nbOutputs = 0;
+        slot->seed = -1;
+    }
+}
+
+SharedMemoryRing::~SharedMemoryRing ( void )
+{
+    for ( size_t i = 0 ; i < _nbSlots ; i++ )
+        getSlot( i )->state.store( STOP );
+    
+    // The workers check their slot periodically. The ones still running after a delay are terminated.
+    for ( int k = 0 ; k < 100 ; k++ )
+    {
+        bool running = false;
+        for ( size_t i = 0 ; i < _nbSlots ; i++ )
+            running = isWorkerAlive( i ) || running;
+        if ( ! running )
+            break;
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+    }
+    for ( size_t i = 0 ; i < _nbSlots ; i++ )
+    {
+        if ( isWorkerAlive( i ) )
+        {
+            kill( -_pids[i] , SIGTERM );
+            waitpid( _pids[i] , nullptr , 0 );
+        }
+    }
+    
+    munmap( _memory , _size );
+    shm_unlink( _name.c_str() );
+}
+
+bool SharedMemoryRing::isWorkerAlive ( size_t slot )
+{
+    if ( _pids[slot] <= 0 )
+        return false;
+    
+    // A worker that exited is collected
+    if ( waitpid( _pids[slot] , nullptr , WNOHANG ) == 0 )
+        return true;
+    
+    _pids[slot] = 0;
+    return false;
+}
+
+bool SharedMemoryRing::startWorker ( size_t slot )
+{
+    std::string command = _workerCommand + " " + _name + " " + std::to_string( slot ) + " " + std::to_string( getpid() );
+    
+    // The output of the trainings is kept in a log per slot
+    command += " > ." + _name.substr( 1 ) + ".worker" + std::to_string( slot ) + ".log 2>&1";
+    
+    // The environment is built before the fork: only exec is called by the child
+    Environment environment = _environment;
+    environment.emplace_back( "HYPERNOMAD_TRACE" , getTraceFileName( slot ) );
+    std::vector<std::string> variables = mergeEnvironment( environment );
+    std::vector<char *> envp;
+    for ( auto & variable : variables )
+        envp.push_back( &variable[0] );
+    envp.push_back( nullptr );
+    
+    pid_t pid = fork();
+    if ( pid < 0 )
+        return false;
+    
+    // Process group of its own: the shell and the worker are killed together
+    if ( pid == 0 )
+    {
+        setpgid( 0 , 0 );
+        execle( "/bin/sh" , "sh" , "-c" , command.c_str() , static_cast<char *>( nullptr ) , envp.data() );
+        _exit( 127 );
+    }
+    setpgid( pid , pid );
+    
+    _pids[slot] = pid;
+    return true;
+}
+
+void SharedMemoryRing::killWorker ( size_t slot )
+{
+    if ( _pids[slot] <= 0 )
+        return;
+    kill( -_pids[slot] , SIGKILL );
+    waitpid( _pids[slot] , nullptr , 0 );
+    _pids[slot] = 0;
+}
+
+bool SharedMemoryRing::evaluate ( const NOMAD::Point & x , int seed , size_t nbOutputs , NOMAD::Point & outputs , std::string & traceFileName , double timeout , bool & timedOut )
+{
+    if ( ! fits( x , nbOutputs ) )
+        return false;
+    
+    size_t slot = acquireSlot();
+    
+    bool success = false;
+    traceFileName.clear();
+    timedOut = false;
+    if ( isWorkerAlive( slot ) || startWorker( slot ) )
+    {
+        SlotHeader * header = getSlot( slot );
+        double * values = getValues( slot );
+        
+        for ( int i = 0 ; i < x.size() ; i++ )
+            values[i] = ( x[i].is_defined() ) ? x[i].value() : std::numeric_limits<double>::quiet_NaN();
+        header->dimension = x.size();
+        header->nbOutputs = static_cast<int32_t>( nbOutputs );
+        header->seed = seed;
+        header->state.store( POINT_READY , std::memory_order_release );
+        
+        // Polling: the evaluations are long compared to the delay
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>( timeout );
+        std::chrono::milliseconds delay ( 1 );
+        int32_t state;
+        while ( ( state = header->state.load( std::memory_order_acquire ) ) == POINT_READY || state == RUNNING )
+        {
+            if ( ! isWorkerAlive( slot ) )
+            {
+                state = FAILED;
+                break;
+            }
+            if ( timeout > 0 && std::chrono::steady_clock::now() >= deadline )
+            {
+                killWorker( slot );
+                timedOut = true;
+                state = FAILED;
+                break;
+            }
+            std::this_thread::sleep_for( delay );
+            delay = std::min( delay * 2 , std::chrono::milliseconds( 100 ) );
+        }
+        
+        if ( state == DONE )
+        {
+            outputs.reset( static_cast<int>( nbOutputs ) );
+            for ( size_t j = 0 ; j < nbOutputs ; j++ )
+                outputs[static_cast<int>(j)] = values[_maxDimension + j];
+            success = outputs.is_complete();
+        }
+        
+        // The trace is moved before the slot is used again
+        std::string slotTraceFileName = getTraceFileName( slot );
+        std::string movedTraceFileName = slotTraceFileName + "." + std::to_string( _nbTraces++ );
+        if ( std::rename( slotTraceFileName.c_str() , movedTraceFileName.c_str() ) == 0 )
+            traceFileName = movedTraceFileName;
+        
+        header->state.store( FREE , std::memory_order_release );
+    }
+    
+    releaseSlot( slot );
+    return success;
+}
+
+#endif
+
+std::string SharedMemoryRing::getTraceFileName ( size_t slot ) const
+{
+    return "." + _name.substr( 1 ) + ".worker" + std::to_string( slot ) + ".trace";
+}
+
+SharedMemoryRing::SlotHeader * SharedMemoryRing::getSlot ( size_t slot ) const
+{
+    return reinterpret_cast<SlotHeader *>( static_cast<char *>( _memory ) + sizeof( Header ) + slot * _slotSize );
+}
+
+double * SharedMemoryRing::getValues ( size_t slot ) const
+{
+    return reinterpret_cast<double *>( reinterpret_cast<char *>( getSlot( slot ) ) + sizeof( SlotHeader ) );
+}
+
+size_t SharedMemoryRing::acquireSlot ( void )
+{
+    std::unique_lock<std::mutex> lock ( _mutex );
+    
+    // Next free slot of the ring
+    size_t slot = _nbSlots;
+    _slotReleased.wait( lock , [&]()
+    {
+        for ( size_t k = 0 ; k < _nbSlots && slot == _nbSlots ; k++ )
+        {
+            if ( ! _busy[( _next + k ) % _nbSlots] )
+                slot = ( _next + k ) % _nbSlots;
+        }
+        return slot < _nbSlots;
+    });
+    
+    _busy[slot] = 1;
+    _next = ( slot + 1 ) % _nbSlots;
+    return slot;
+}
+
+void SharedMemoryRing::releaseSlot ( size_t slot )
+{
+    {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        _busy[slot] = 0;
+    }
+    _slotReleased.notify_one();
+}
@@ -0,0 +1,128 @@
+//
+//  sharedMemoryRing.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __SHAREDMEMORYRING__
+#define __SHAREDMEMORYRING__
+
+#include "nomad.hpp"
+#include "fileutils.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Transfer of the points to persistent worker processes (BB_TRANSFER SHARED_MEMORY) without files,
+// shell commands or text conversions. A POSIX shared memory segment has a ring of slots of fixed size,
+// one per worker process (src/blackbox/shm_worker.py). A slot has the point and the outputs as doubles:
+//     header: magic, number of slots, maximum dimension, maximum number of outputs (4 x uint32)
+//     slot:   state, dimension, number of outputs, seed (4 x int32), maximum dimension + maximum number of outputs doubles
+// The driver writes the point and sets POINT_READY, the worker sets RUNNING, then DONE or FAILED when the outputs are written.
+// A worker process is started when its slot is first used and started again if it died.
+// Each worker writes the training trace of its evaluation in a file per slot (HYPERNOMAD_TRACE).
+// Not available with Visual Studio.
+class SharedMemoryRing
+{
+public:
+    
+    enum SlotState : int32_t { FREE = 0 , POINT_READY = 1 , RUNNING = 2 , DONE = 3 , FAILED = 4 , STOP = 5 };
+    
+    static const uint32_t MAGIC = 0x484e5348;
+    
+private:
+    
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t nbSlots;
+        uint32_t maxDimension;
+        uint32_t maxOutputs;
+    };
+    
+    struct SlotHeader
+    {
+        std::atomic<int32_t> state;
+        int32_t dimension;
+        int32_t nbOutputs;
+        int32_t seed;
+    };
+    
+    std::string _name;
+    std::string _workerCommand;
+    Environment _environment;
+    
+    size_t _nbSlots;
+    size_t _maxDimension;
+    size_t _maxOutputs;
+    size_t _slotSize;
+    size_t _size;
+    void * _memory;
+    
+    // Worker process of each slot (0 if not started) and slots used by an evaluation
+    std::vector<int> _pids;
+    std::vector<char> _busy;
+    size_t _next;
+    std::atomic<size_t> _nbTraces;
+    
+    std::mutex _mutex;
+    std::condition_variable _slotReleased;
+    
+    SlotHeader * getSlot ( size_t slot ) const;
+    double * getValues ( size_t slot ) const;
+    
+    size_t acquireSlot ( void );
+    void releaseSlot ( size_t slot );
+    
+    std::string getTraceFileName ( size_t slot ) const;
+    
+    bool isWorkerAlive ( size_t slot );
+    void killWorker ( size_t slot );
+    bool startWorker ( size_t slot );
+    
+public:
+    
+    // The worker command (with the dataset) is followed by the name of the shared memory, the slot and the pid of the driver.
+    // The variables of environment are given to the workers.
+    SharedMemoryRing ( const std::string & workerCommand , const Environment & environment , size_t nbSlots , size_t maxDimension , size_t maxOutputs );
+    
+    // Stop the workers and remove the shared memory
+    ~SharedMemoryRing ( void );
+    
+    SharedMemoryRing ( const SharedMemoryRing & ) = delete;
+    void operator= ( const SharedMemoryRing & ) = delete;
+    
+    // Evaluate a point on a free slot (wait for a slot). Return false if the evaluation failed or if the point does not fit in a slot.
+    // The training trace of the evaluation is moved to a file of its own (traceFileName, empty if there is no trace).
+    // With a time budget in seconds (none if 0), the worker is killed when it is exceeded (timedOut is true) and started again for the next point.
+    bool evaluate ( const NOMAD::Point & x , int seed , size_t nbOutputs , NOMAD::Point & outputs , std::string & traceFileName , double timeout , bool & timedOut );
+    
+    bool fits ( const NOMAD::Point & x , size_t nbOutputs ) const { return static_cast<size_t>( x.size() ) <= _maxDimension && nbOutputs <= _maxOutputs; }
+    
+    const std::string & getName ( void ) const { return _name; }
+    
+};
+
+#endif
@@ -0,0 +1,173 @@
+//
+//  syntheticBlackbox.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "syntheticBlackbox.hpp"
+
+#include <chrono>
+#include <thread>
+
+const std::string SyntheticBlackbox::prefix = "SYNTHETIC:";
+
+bool SyntheticBlackbox::isSynthetic ( const std::string & command )
+{
+    std::string start = command.substr( 0 , prefix.size() );
+    NOMAD::toupper( start );
+    return ( start.compare( prefix ) == 0 );
+}
+
+SyntheticBlackbox::SyntheticBlackbox ( const std::string & command , const HyperParameters & hyperParameters ) :
+_function ( Function::LAYERS ),
+_sleepMs ( 0 ),
+_noise ( 0.0 ),
+_layout ( hyperParameters.getBlockLayout() ),
+_rng ( 0 )
+{
+    if ( ! isSynthetic( command ) )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "SyntheticBlackbox: invalid command " + command );
+    
+    // First word without the prefix: FUNCTION[:SLEEP_MS[:NOISE]]
+    std::string spec = command.substr( prefix.size() );
+    spec = spec.substr( 0 , spec.find( ' ' ) );
+    
+    std::vector<std::string> fields;
+    std::istringstream iss ( spec );
+    std::string field;
+    while ( std::getline( iss , field , ':' ) )
+        fields.push_back( field );
+    
+    if ( fields.empty() || fields.size() > 3 )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "SyntheticBlackbox: invalid command " + command + " (synthetic:FUNCTION[:SLEEP_MS[:NOISE]])" );
+    
+    NOMAD::toupper( fields[0] );
+    if ( fields[0].compare( "SPHERE" ) == 0 )
+        _function = Function::SPHERE;
+    else if ( fields[0].compare( "LAYERS" ) == 0 )
+        _function = Function::LAYERS;
+    else if ( fields[0].compare( "RASTRIGIN" ) == 0 )
+        _function = Function::RASTRIGIN;
+    else
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "SyntheticBlackbox: unknown function " + fields[0] );
+    
+    int i;
+    if ( fields.size() > 1 )
+    {
+        if ( ! NOMAD::atoi( fields[1] , i ) || i < 0 )
+            throw NOMAD::Exception ( __FILE__ , __LINE__ , "SyntheticBlackbox: invalid sleep time " + fields[1] );
+        _sleepMs = i;
+    }
+    
+    if ( fields.size() > 2 )
+    {
+        NOMAD::Double d;
+        if ( ! d.atof( fields[2] ) || ! d.is_defined() || d < 0 )
+            throw NOMAD::Exception ( __FILE__ , __LINE__ , "SyntheticBlackbox: invalid noise " + fields[2] );
+        _noise = d.value();
+    }
+}
+
+double SyntheticBlackbox::normalize ( const NOMAD::Double & v , const NOMAD::Double & lb , const NOMAD::Double & ub )
+{
+    if ( ! lb.is_defined() || ! ub.is_defined() || lb == ub )
+        return v.value();
+    return ( v.value() - lb.value() ) / ( ub.value() - lb.value() );
+}
+
+bool SyntheticBlackbox::computeObjective ( const NOMAD::Point & x , double & f ) const
+{
+    // The optimum of each hyperparameter is at 30% of its range and the best networks have 3 groups per block (3 layers)
+    const double optimum = 0.3;
+    const size_t bestNbGroups = 3;
+    
+    double structure = 0.0;
+    double sum = 0.0;
+    size_t nbTerms = 0;
+    
+    auto term = [this,optimum]( double t )
+    {
+        double z = t - optimum;
+        if ( _function == Function::RASTRIGIN )
+        {
+            z *= 10.24;
+            return z * z - 10.0 * std::cos( 2.0 * 3.14159265358979323846 * z ) + 10.0;
+        }
+        return z * z;
+    };
+    
+    int index = 0;
+    for ( const auto & block : _layout )
+    {
+        if ( index >= x.size() )
+            return false;
+        
+        const NOMAD::Double & head = x[index++];
+        
+        size_t nbGroups = ( block.groupSize == 0 ) ? 0 : 1;
+        if ( block.multipleGroups )
+        {
+            if ( ! head.is_defined() || head < 0 )
+                return false;
+            nbGroups = static_cast<size_t>( head.round() );
+            
+            double d = ( static_cast<double>( nbGroups ) - bestNbGroups ) / 2.0;
+            structure += d * d;
+        }
+        else
+        {
+            sum += term( normalize( head , block.headLowerBound , block.headUpperBound ) );
+            nbTerms++;
+        }
+        
+        for ( size_t g = 0 ; g < nbGroups ; g++ )
+        {
+            for ( size_t j = 0 ; j < block.groupSize ; j++ )
+            {
+                if ( index >= x.size() )
+                    return false;
+                sum += term( normalize( x[index++] , block.lowerBounds[j] , block.upperBounds[j] ) );
+                nbTerms++;
+            }
+        }
+    }
+    if ( index != x.size() )
+        return false;
+    
+    switch ( _function )
+    {
+        case Function::SPHERE :
+            f = sum + structure;
+            break;
+        case Function::LAYERS :
+            // Error rate (%) decreasing with the quality of the architecture
+            f = 100.0 * ( 1.0 - std::exp( - structure - 10.0 * sum / std::max( nbTerms , static_cast<size_t>(1) ) ) );
+            break;
+        case Function::RASTRIGIN :
+            f = sum / std::max( nbTerms , static_cast<size_t>(1) ) + structure;
+            break;
+    }
+    return true;
+}
+
+bool SyntheticBlackbox::evaluate ( const NOMAD::Point & x , NOMAD::Double & f ) const
+{
+    double v;
+    if ( ! computeObjective( x , v ) )
+        return false;
+    
+    if ( _noise > 0 )
+    {
+        std::lock_guard<std::mutex> lock ( _rngMutex );
+        std::normal_distribution<double> normal ( 0.0 , _noise );
+        v += normal( _rng );
+    }
+    
+    // Emulate the training time
+    if ( _sleepMs > 0 )
+        std::this_thread::sleep_for( std::chrono::milliseconds( _sleepMs ) );
+    
+    f = v;
+    return true;
+}
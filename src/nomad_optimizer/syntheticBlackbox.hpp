@@ -0,0 +1,80 @@
+//
+//  syntheticBlackbox.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __SYNTHETICBLACKBOX__
+#define __SYNTHETICBLACKBOX__
+
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+
+#include <mutex>
+#include <random>
+
+// Analytic objectives evaluated in process instead of training a network.
+// They are used to measure the overhead of HyperNomad. The blackbox is selected with
+//     BB_EXE synthetic:FUNCTION[:SLEEP_MS[:NOISE]]
+// FUNCTION is SPHERE, LAYERS or RASTRIGIN. SLEEP_MS emulates the training time (default 0)
+// and NOISE is the standard deviation of a gaussian noise added to the objective (default 0).
+// The point is decoded with the block layout (heads give the number of groups).
+class SyntheticBlackbox
+{
+public:
+    
+    enum class Function { SPHERE , LAYERS , RASTRIGIN };
+    
+private:
+    
+    Function _function;
+    size_t _sleepMs;
+    double _noise;
+    
+    std::vector<HyperParameters::BlockLayout> _layout;
+    
+    mutable std::mt19937 _rng;
+    mutable std::mutex _rngMutex;
+    
+    // Position in [0,1] within the bounds (the value itself if a bound is undefined)
+    static double normalize ( const NOMAD::Double & v , const NOMAD::Double & lb , const NOMAD::Double & ub );
+    
+public:
+    
+    static const std::string prefix;
+    
+    // True if the blackbox command starts with synthetic:
+    static bool isSynthetic ( const std::string & command );
+    
+    // The command is the BB_EXE value (the dataset name that follows is ignored)
+    SyntheticBlackbox ( const std::string & command , const HyperParameters & hyperParameters );
+    
+    // Return false if the point is not consistent with the block layout
+    bool evaluate ( const NOMAD::Point & x , NOMAD::Double & f ) const;
+    
+    // Same without the sleep and the noise (to measure the cost of the function itself)
+    bool computeObjective ( const NOMAD::Point & x , double & f ) const;
+    
+};
+
+#endif
@@ -0,0 +1,252 @@
+//
+//  warmStart.cpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+
+#include "warmStart.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace
+{
+    // Bandwidth of the kernel (normalized distance) and weight of the median in the regression of a file
+    const double bandwidth = 0.1;
+    const double medianWeight = 0.5;
+    
+    bool hasSuffix ( const std::string & s , const std::string & suffix )
+    {
+        return s.size() >= suffix.size() && s.compare( s.size() - suffix.size() , suffix.size() , suffix ) == 0;
+    }
+}
+
+WarmStart::WarmStart ( const std::vector<HyperParameters::BlockLayout> & layout , const std::vector<std::string> & fileNames ) :
+_layout ( layout )
+{
+    for ( const auto & fileName : fileNames )
+    {
+        std::vector<std::pair<NOMAD::Point,double>> points;
+        if ( hasSuffix( fileName , ".bin" ) )
+            readCache( fileName , points );
+        else
+            readHistory( fileName , points );
+        add( points );
+    }
+}
+
+size_t WarmStart::getPointDimension ( const std::vector<NOMAD::Double> & values , std::vector<int> & structure ) const
+{
+    structure.clear();
+    
+    size_t index = 0;
+    for ( const auto & block : _layout )
+    {
+        if ( index >= values.size() || ! values[index].is_defined() )
+            return 0;
+        
+        int head = values[index++].round();
+        
+        size_t nbGroups = ( block.groupSize == 0 ) ? 0 : 1;
+        if ( block.multipleGroups )
+        {
+            nbGroups = ( head > 0 ) ? static_cast<size_t>( head ) : 0;
+            structure.push_back( head );
+        }
+        
+        index += nbGroups * block.groupSize;
+    }
+    return ( index <= values.size() ) ? index : 0;
+}
+
+std::vector<double> WarmStart::getRanges ( const NOMAD::Point & x ) const
+{
+    auto range = []( const NOMAD::Double & lb , const NOMAD::Double & ub ) -> double
+    {
+        return ( lb.is_defined() && ub.is_defined() && ub > lb ) ? ( ub - lb ).value() : 0.0;
+    };
+    
+    std::vector<double> ranges;
+    int index = 0;
+    for ( const auto & block : _layout )
+    {
+        if ( index >= x.size() )
+            break;
+        
+        int head = x[index++].round();
+        ranges.push_back( range( block.headLowerBound , block.headUpperBound ) );
+        
+        size_t nbGroups = ( block.groupSize == 0 ) ? 0 : 1;
+        if ( block.multipleGroups )
+            nbGroups = ( head > 0 ) ? static_cast<size_t>( head ) : 0;
+        
+        for ( size_t g = 0 ; g < nbGroups ; g++ )
+            for ( size_t j = 0 ; j < block.groupSize ; j++ , index++ )
+                ranges.push_back( range( block.lowerBounds[j] , block.upperBounds[j] ) );
+    }
+    return ranges;
+}
+
+// A line of history.txt: the point followed by the outputs ("-" for an undefined value)
+void WarmStart::readHistory ( const std::string & fileName , std::vector<std::pair<NOMAD::Point,double>> & points ) const
+{
+    std::ifstream fin ( fileName.c_str() );
+    if ( fin.fail() )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "WarmStart: cannot read the history file " + fileName );
+    
+    std::string line;
+    while ( std::getline( fin , line ) )
+    {
+        std::istringstream iss ( line );
+        std::vector<NOMAD::Double> values;
+        std::string s;
+        bool valid = true;
+        while ( valid && iss >> s )
+        {
+            if ( s == "-" )
+            {
+                values.push_back( NOMAD::Double() );
+                continue;
+            }
+            char * end;
+            double v = std::strtod( s.c_str() , &end );
+            valid = ( *end == '\0' );
+            values.push_back( v );
+        }
+        
+        std::vector<int> structure;
+        size_t n = getPointDimension( values , structure );
+        if ( ! valid || n == 0 || n >= values.size() || ! values[n].is_defined() || ! std::isfinite( values[n].value() ) )
+            continue;
+        if ( std::any_of( values.begin() , values.begin() + n , []( const NOMAD::Double & v ) { return ! v.is_defined(); } ) )
+            continue;
+        
+        NOMAD::Point x ( static_cast<int>( n ) );
+        for ( size_t i = 0 ; i < n ; i++ )
+            x[static_cast<int>(i)] = values[i];
+        points.push_back( std::make_pair( x , values[n].value() ) );
+    }
+}
+
+void WarmStart::readCache ( const std::string & fileName , std::vector<std::pair<NOMAD::Point,double>> & points ) const
+{
+    NOMAD::Display out ( std::cout );
+    NOMAD::Cache cache ( out , NOMAD::TRUTH );
+    if ( ! cache.load( fileName , NULL , false ) )
+        throw NOMAD::Exception ( __FILE__ , __LINE__ , "WarmStart: cannot read the cache file " + fileName );
+    
+    for ( const NOMAD::Eval_Point * x = cache.begin() ; x ; x = cache.next() )
+    {
+        const NOMAD::Point & outputs = x->get_bb_outputs();
+        if ( x->get_eval_status() != NOMAD::EVAL_OK || ! x->is_complete() || outputs.size() == 0 || ! outputs[0].is_defined() || ! std::isfinite( outputs[0].value() ) )
+            continue;
+        
+        std::vector<NOMAD::Double> values ( x->size() );
+        for ( int i = 0 ; i < x->size() ; i++ )
+            values[i] = (*x)[i];
+        
+        std::vector<int> structure;
+        if ( getPointDimension( values , structure ) != values.size() )
+            continue;
+        
+        points.push_back( std::make_pair( NOMAD::Point( *x ) , outputs[0].value() ) );
+    }
+}
+
+// The quantiles of a file: mean rank of the equal objectives divided by the number of points minus one
+void WarmStart::add ( std::vector<std::pair<NOMAD::Point,double>> & points )
+{
+    std::stable_sort( points.begin() , points.end() , []( const std::pair<NOMAD::Point,double> & a , const std::pair<NOMAD::Point,double> & b ) { return a.second < b.second; } );
+    
+    const size_t file = _nbEntriesPerFile.size();
+    const double n = static_cast<double>( points.size() );
+    for ( size_t i = 0 ; i < points.size() ; )
+    {
+        size_t last = i;
+        while ( last + 1 < points.size() && points[last+1].second == points[i].second )
+            last++;
+        
+        double quantile = ( points.size() > 1 ) ? 0.5 * ( i + last ) / ( n - 1 ) : 0.0;
+        for ( ; i <= last ; i++ )
+        {
+            Entry e;
+            e.x = points[i].first;
+            std::vector<NOMAD::Double> values ( e.x.size() );
+            for ( int j = 0 ; j < e.x.size() ; j++ )
+                values[j] = e.x[j];
+            getPointDimension( values , e.structure );
+            e.quantile = quantile;
+            e.file = file;
+            _entries.push_back( e );
+        }
+    }
+    _nbEntriesPerFile.push_back( points.size() );
+}
+
+double WarmStart::predict ( const NOMAD::Point & x ) const
+{
+    std::vector<NOMAD::Double> values ( x.size() );
+    for ( int i = 0 ; i < x.size() ; i++ )
+        values[i] = x[i];
+    std::vector<int> structure;
+    getPointDimension( values , structure );
+    
+    std::vector<double> ranges = getRanges( x );
+    
+    // Kernel regression of each file
+    std::vector<double> sumWeights ( _nbEntriesPerFile.size() , 0.0 ) , sumQuantiles ( _nbEntriesPerFile.size() , 0.0 );
+    for ( const auto & e : _entries )
+    {
+        if ( e.x.size() != x.size() || e.structure != structure )
+            continue;
+        
+        double d2 = 0;
+        for ( int i = 0 ; i < x.size() ; i++ )
+        {
+            double delta = ( x[i] - e.x[i] ).abs().value();
+            double r = ( ranges[i] > 0 ) ? ranges[i] : std::max( { std::fabs( x[i].value() ) , std::fabs( e.x[i].value() ) , 1.0 } );
+            d2 += ( delta / r ) * ( delta / r );
+        }
+        
+        double w = std::exp( - d2 / ( bandwidth * bandwidth ) );
+        sumWeights[e.file] += w;
+        sumQuantiles[e.file] += w * e.quantile;
+    }
+    
+    double prediction = 0;
+    for ( size_t f = 0 ; f < _nbEntriesPerFile.size() ; f++ )
+        prediction += ( sumQuantiles[f] + medianWeight * 0.5 ) / ( sumWeights[f] + medianWeight );
+    
+    return ( _nbEntriesPerFile.empty() ) ? 0.5 : prediction / _nbEntriesPerFile.size();
+}
+
+std::vector<NOMAD::Point> WarmStart::getBestPoints ( const HyperParameters & hyperParameters , size_t n ) const
+{
+    std::vector<std::pair<double,size_t>> ranking;
+    for ( size_t i = 0 ; i < _entries.size() ; i++ )
+        ranking.push_back( std::make_pair( predict( _entries[i].x ) , i ) );
+    
+    // Ties broken by the quantile in the file of the point
+    std::sort( ranking.begin() , ranking.end() , [&]( const std::pair<double,size_t> & a , const std::pair<double,size_t> & b )
+              {
+                  if ( a.first != b.first )
+                      return a.first < b.first;
+                  return _entries[a.second].quantile < _entries[b.second].quantile;
+              } );
+    
+    std::vector<NOMAD::Point> best;
+    std::set<NOMAD::Point> selected;
+    for ( size_t k = 0 ; k < ranking.size() && best.size() < n ; k++ )
+    {
+        NOMAD::Point projected;
+        if ( ! hyperParameters.projectPoint( _entries[ranking[k].second].x , projected ) || ! selected.insert( projected ).second )
+            continue;
+        best.push_back( projected );
+    }
+    return best;
+}
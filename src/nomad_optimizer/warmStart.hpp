@@ -0,0 +1,82 @@
+//
+//  warmStart.hpp
+//  HyperNomad
+//
+//  Copyright © 2019 GERAD. All rights reserved.
+//
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+#ifndef __WARMSTART__
+#define __WARMSTART__
+
+#include "nomad.hpp"
+#include "hyperParameters.hpp"
+
+// Points of previous campaigns (WARM_START) ranked for the initial design of a campaign.
+// A history (history.txt) has a line per evaluation: the point followed by the outputs, the first output is the
+// objective. A file ending with .bin is a Nomad cache file. The objectives of different datasets cannot be compared:
+// in each file, a point is scored by the quantile of its objective (0 for the best, 1 for the worst).
+// The cross-dataset model predicts the quantile of a point by the mean over the files of a kernel regression on
+// the points with the same structure (distance normalized by the bounds). The regression of a file is shrunk toward
+// the median: a file without a neighbor predicts 0.5. A point good for a single dataset whose neighbors are poor
+// for the other datasets is ranked after a point good for all.
+class WarmStart
+{
+private:
+    
+    struct Entry
+    {
+        NOMAD::Point x;
+        std::vector<int> structure; // Head values of the blocks with multiple groups
+        double quantile;
+        size_t file;
+    };
+    
+    std::vector<HyperParameters::BlockLayout> _layout;
+    std::vector<Entry> _entries;
+    std::vector<size_t> _nbEntriesPerFile;
+    
+    // Number of coordinates of the point at the beginning of the values (0 if it does not have the blocks of the schema)
+    size_t getPointDimension ( const std::vector<NOMAD::Double> & values , std::vector<int> & structure ) const;
+    
+    // Range of each coordinate of a point for the normalized distance
+    std::vector<double> getRanges ( const NOMAD::Point & x ) const;
+    
+    void readHistory ( const std::string & fileName , std::vector<std::pair<NOMAD::Point,double>> & points ) const;
+    void readCache ( const std::string & fileName , std::vector<std::pair<NOMAD::Point,double>> & points ) const;
+    
+    void add ( std::vector<std::pair<NOMAD::Point,double>> & points );
+    
+public:
+    
+    WarmStart ( const std::vector<HyperParameters::BlockLayout> & layout , const std::vector<std::string> & fileNames );
+    
+    size_t size ( void ) const { return _entries.size(); }
+    size_t getNbFiles ( void ) const { return _nbEntriesPerFile.size(); }
+    
+    // Predicted quantile of a point
+    double predict ( const NOMAD::Point & x ) const;
+    
+    // The n points of the files with the best predicted quantiles, projected in the search space of the campaign (distinct points)
+    std::vector<NOMAD::Point> getBestPoints ( const HyperParameters & hyperParameters , size_t n ) const;
+};
+
+#endif
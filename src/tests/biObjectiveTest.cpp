@@ -0,0 +1,74 @@
+/* ------------------------------------------------------------------------------*/
+/*  HyperNOMAD - Hyper-parameter optimization of deep neural networks with NOMAD */
+/*                                                                               */
+/*                                                                               */
+/*  This program is free software: you can redistribute it and/or modify it      */
+/*  under the terms of the GNU Lesser General Public License as published by     */
+/*  the Free Software Foundation, either version 3 of the License, or (at your   */
+/*  option) any later version.                                                   */
+/*                                                                               */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT  */
+/*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        */
+/*  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  */
+/*  for more details.                                                            */
+/*                                                                               */
+/*  You should have received a copy of the GNU Lesser General Public License     */
+/*  along with this program. If not, see <http://www.gnu.org/licenses/>.         */
+/*                                                                               */
+/*  You can find information on the NOMAD software at www.gerad.ca/nomad         */
+/* ------------------------------------------------------------------------------*/
+
+
+
+/*-------------------------------------------------------------------*/
+/*   Test of the bi-objective campaign (BiMads) with the synthetic   */
+/*   blackbox: the Pareto archive has several non dominated points   */
+/*-------------------------------------------------------------------*/
+#include "nomad.hpp"
+#include "campaign.hpp"
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+const std::string testFileName = "biObjectiveTest_hyperparameters.txt";
+
+// The synthetic objective is minimal with 3 groups per block: the number of parameters (second objective) is in
+// conflict with it and the front of BiMads has several points
+int main ( void )
+{
+    std::ofstream fout ( testFileName.c_str() );
+    fout << "DATASET MNIST" << std::endl;
+    fout << "BB_EXE synthetic:layers" << std::endl;
+    fout << "SECOND_OBJECTIVE PARAMETERS" << std::endl;
+    fout << "MAX_BB_EVAL 300" << std::endl;
+    fout << "INITIAL_DESIGN 10" << std::endl;
+    fout << "HYPER_DISPLAY 0" << std::endl;
+    fout.close();
+    
+    try
+    {
+        NOMAD::Display out ( std::cout );
+        Campaign campaign ( testFileName , "" , "" , out );
+        campaign.run();
+        
+        std::shared_ptr<const ParetoArchive> archive = campaign.getParetoArchive();
+        const size_t size = ( archive ) ? archive->size() : 0;
+        std::remove( testFileName.c_str() );
+        
+        if ( size < 2 )
+        {
+            std::cerr << "biObjectiveTest failed: " << size << " non dominated point(s) after " << campaign.getStats().nbEval << " evaluations" << std::endl;
+            return 1;
+        }
+        std::cout << "biObjectiveTest passed: " << size << " non dominated points" << std::endl;
+    }
+    catch ( std::exception & e )
+    {
+        std::remove( testFileName.c_str() );
+        std::cerr << "biObjectiveTest failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}